@@ -46,6 +46,10 @@ android {
             version = "3.22.1"
         }
     }
+    // circuit.dat / circuit.zkey 를 압축하지 않아야 AssetFileDescriptor 로 APK 안을 바로 mmap 할 수 있다
+    androidResources {
+        noCompress += listOf("dat", "zkey")
+    }
     compileOptions {
         sourceCompatibility = JavaVersion.VERSION_11
         targetCompatibility = JavaVersion.VERSION_11
@@ -3,15 +3,17 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
-#include <android/log.h>
 #include <sys/time.h>
+#include "native_log.hpp"
+#include "witness/mappedfile.hpp"
 
 // Rapidsnark C API 헤더 포함 (groth16.hpp 대신 사용)
 #include "prover.h"
 
 #define TAG "NativeProver"
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, TAG, __VA_ARGS__)
+#define LOGD(...) NATIVE_LOGD(TAG, __VA_ARGS__)
+#define LOGI(...) NATIVE_LOGI(TAG, __VA_ARGS__)
+#define LOGE(...) NATIVE_LOGE(TAG, __VA_ARGS__)
 
 // 파일 내용을 바이너리 버퍼로 읽는 헬퍼 함수
 std::vector<char> readFileToBuffer(const std::string& filePath) {
@@ -29,20 +31,10 @@ std::vector<char> readFileToBuffer(const std::string& filePath) {
     return {};
 }
 
-extern "C" JNIEXPORT jstring JNICALL
-Java_com_example_contacticalattestation_zk_NativeProver_generateProof(
-        JNIEnv* env,
-        jobject /* this */,
-        jstring zkeyPath,
-        jstring wtnsPath) {
-
-    const char *zkey_path = env->GetStringUTFChars(zkeyPath, 0);
-    const char *wtns_path = env->GetStringUTFChars(wtnsPath, 0);
-
-    LOGD("🚀 Starting Proof Generation (C API)...");
-    LOGD("📂 ZKey Path: %s", zkey_path);
-    LOGD("📂 Witness Path: %s", wtns_path);
-
+// Witness 파일을 읽어 prove 로 증명을 만든다. proof JSON 또는 "ERROR_..." 를 돌려준다
+// prove(wtns, wtnsSize, proof, &proofSize, public, &publicSize, errorMsg, errorMsgSize) 는 rapidsnark 상태 코드를 돌려준다
+template <typename ProveFn>
+static std::string proveWitnessFile(const char *wtns_path, ProveFn prove) {
     struct timeval t1, t2;
     gettimeofday(&t1, NULL);
 
@@ -52,9 +44,7 @@ Java_com_example_contacticalattestation_zk_NativeProver_generateProof(
     std::vector<char> wtnsBuffer = readFileToBuffer(wtns_path);
     if (wtnsBuffer.empty()) {
         LOGE("❌ Failed to read witness file: %s", wtns_path);
-        env->ReleaseStringUTFChars(zkeyPath, zkey_path);
-        env->ReleaseStringUTFChars(wtnsPath, wtns_path);
-        return env->NewStringUTF("ERROR_READ_WTNS");
+        return "ERROR_READ_WTNS";
     }
 
     // 2. 출력 버퍼 준비
@@ -68,9 +58,7 @@ Java_com_example_contacticalattestation_zk_NativeProver_generateProof(
     char errorMsg[256];
 
     // 3. Rapidsnark Prover 실행 (C API)
-    // int groth16_prover_zkey_file(...)
-    int status = groth16_prover_zkey_file(
-            zkey_path,
+    int status = prove(
             wtnsBuffer.data(),
             wtnsBuffer.size(),
             proofBuffer.data(),
@@ -89,7 +77,7 @@ Java_com_example_contacticalattestation_zk_NativeProver_generateProof(
         // std::string publicStr(publicBuffer.data());
         
         resultJson = proofStr;
-        LOGD("✅ Proof Generated Successfully!");
+        LOGI("✅ Proof Generated Successfully!");
     } else {
         LOGE("❌ Proof Generation Failed (Code %d): %s", status, errorMsg);
         resultJson = "ERROR_PROVE";
@@ -97,10 +85,87 @@ Java_com_example_contacticalattestation_zk_NativeProver_generateProof(
 
     gettimeofday(&t2, NULL);
     double elapsedTime = (t2.tv_sec - t1.tv_sec) * 1000.0 + (t2.tv_usec - t1.tv_usec) / 1000.0;
-    LOGD("⏱️ Time taken: %.2f ms", elapsedTime);
+    LOGI("⏱️ Time taken: %.2f ms", elapsedTime);
+
+    return resultJson;
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_example_contacticalattestation_zk_NativeProver_generateProof(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring zkeyPath,
+        jstring wtnsPath) {
+
+    const char *zkey_path = env->GetStringUTFChars(zkeyPath, 0);
+    const char *wtns_path = env->GetStringUTFChars(wtnsPath, 0);
+
+    LOGD("🚀 Starting Proof Generation (C API)...");
+    LOGD("📂 ZKey Path: %s", zkey_path);
+    LOGD("📂 Witness Path: %s", wtns_path);
+
+    // int groth16_prover_zkey_file(...)
+    std::string resultJson = proveWitnessFile(wtns_path,
+            [zkey_path](const void *wtns, unsigned long long wtnsSize,
+                        char *proof, unsigned long long *proofSize,
+                        char *pub, unsigned long long *publicSize,
+                        char *errorMsg, unsigned long long errorMsgSize) {
+                return groth16_prover_zkey_file(zkey_path, wtns, wtnsSize, proof, proofSize,
+                                                pub, publicSize, errorMsg, errorMsgSize);
+            });
 
     env->ReleaseStringUTFChars(zkeyPath, zkey_path);
     env->ReleaseStringUTFChars(wtnsPath, wtns_path);
 
     return env->NewStringUTF(resultJson.c_str());
-}
\ No newline at end of file
+}
+
+// generateProof 와 같지만 zkey 를 열린 fd 의 [zkeyOffset, zkeyOffset + zkeyLength) 에서 매핑한다 (zkeyLength 0 = 끝까지).
+// APK 에 압축 없이 들어 있는 circuit.zkey 를 캐시로 복사하지 않고 AssetFileDescriptor 로 바로 넘길 때 쓴다.
+// 매핑은 prover 를 해제할 때까지 유지하고, fd 는 닫지 않는다
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_example_contacticalattestation_zk_NativeProver_generateProofFd(
+        JNIEnv* env,
+        jobject /* this */,
+        jint zkeyFd,
+        jlong zkeyOffset,
+        jlong zkeyLength,
+        jstring wtnsPath) {
+
+    LOGD("🚀 Starting Proof Generation (C API, zkey fd %d [%lld +%lld])...", (int)zkeyFd,
+         (long long)zkeyOffset, (long long)zkeyLength);
+
+    Circom_MappedFile zkey;
+    if (zkeyFd < 0 || zkeyOffset < 0 || zkeyLength < 0 ||
+        !zkey.open((int)zkeyFd, (uint64_t)zkeyOffset, (uint64_t)zkeyLength)) {
+        LOGE("❌ Failed to map zkey range: fd %d [%lld +%lld]", (int)zkeyFd,
+             (long long)zkeyOffset, (long long)zkeyLength);
+        return env->NewStringUTF("ERROR_READ_ZKEY");
+    }
+    // 파싱은 앞에서부터 한 번 훑는다
+    zkey.advise(0, zkey.size(), MADV_SEQUENTIAL);
+
+    void *prover = NULL;
+    char errorMsg[256];
+    if (groth16_prover_create(&prover, zkey.data(), zkey.size(), errorMsg, sizeof(errorMsg)) != PROVER_OK) {
+        LOGE("❌ Failed to load zkey: %s", errorMsg);
+        return env->NewStringUTF("ERROR_READ_ZKEY");
+    }
+
+    const char *wtns_path = env->GetStringUTFChars(wtnsPath, 0);
+    LOGD("📂 Witness Path: %s", wtns_path);
+
+    std::string resultJson = proveWitnessFile(wtns_path,
+            [prover](const void *wtns, unsigned long long wtnsSize,
+                     char *proof, unsigned long long *proofSize,
+                     char *pub, unsigned long long *publicSize,
+                     char *errorMsg, unsigned long long errorMsgSize) {
+                return groth16_prover_prove(prover, wtns, wtnsSize, proof, proofSize,
+                                            pub, publicSize, errorMsg, errorMsgSize);
+            });
+
+    groth16_prover_destroy(prover);
+    env->ReleaseStringUTFChars(wtnsPath, wtns_path);
+
+    return env->NewStringUTF(resultJson.c_str());
+}
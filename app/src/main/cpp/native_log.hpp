@@ -0,0 +1,55 @@
+#ifndef NATIVE_LOG_HPP
+#define NATIVE_LOG_HPP
+
+// 네이티브 라이브러리 공용 로그 매크로.
+//
+// NATIVE_LOG_LEVEL 보다 낮은 우선순위의 호출은 상수 조건으로 감싸져 컴파일 단계에서 사라진다
+// (형식 문자열도, 인자 계산도 남지 않는다). __android_log_print 는 로그를 버리더라도 먼저 문자열을
+// 만들기 때문에, 끄는 것은 여기서 해야 한다.
+// 기본값은 NDEBUG 빌드 (Release / RelWithDebInfo) 에서 INFO, 디버그 빌드에서 DEBUG 이고,
+// CMake 의 -DNATIVE_LOG_LEVEL=<2..6> 로 바꿀 수 있다.
+//
+//   VERBOSE: 입력/스레드마다 찍히는 hot path 추적
+//   DEBUG:   단계별 진행 (로드, 파싱, 생성/소멸)
+//   INFO:    호출당 한 번의 결과 요약
+//   ERROR:   실패
+//
+// 사용법 (파일마다 TAG 를 정한다):
+//   #define TAG "NativeWitness"
+//   #define LOGD(...) NATIVE_LOGD(TAG, __VA_ARGS__)
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#else
+// x86_64 서버/벤치마크 빌드용: stderr 로
+#include <stdio.h>
+#define ANDROID_LOG_VERBOSE 2
+#define ANDROID_LOG_DEBUG 3
+#define ANDROID_LOG_INFO 4
+#define ANDROID_LOG_WARN 5
+#define ANDROID_LOG_ERROR 6
+#define __android_log_print(prio, tag, ...) \
+    (fprintf(stderr, "[%s] ", tag), fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+#endif
+
+#ifndef NATIVE_LOG_LEVEL
+#ifdef NDEBUG
+#define NATIVE_LOG_LEVEL ANDROID_LOG_INFO
+#else
+#define NATIVE_LOG_LEVEL ANDROID_LOG_DEBUG
+#endif
+#endif
+
+#define NATIVE_LOG(prio, tag, ...)                           \
+    do {                                                     \
+        if ((prio) >= NATIVE_LOG_LEVEL) {                    \
+            __android_log_print(prio, tag, __VA_ARGS__);     \
+        }                                                    \
+    } while (0)
+
+#define NATIVE_LOGV(tag, ...) NATIVE_LOG(ANDROID_LOG_VERBOSE, tag, __VA_ARGS__)
+#define NATIVE_LOGD(tag, ...) NATIVE_LOG(ANDROID_LOG_DEBUG, tag, __VA_ARGS__)
+#define NATIVE_LOGI(tag, ...) NATIVE_LOG(ANDROID_LOG_INFO, tag, __VA_ARGS__)
+#define NATIVE_LOGE(tag, ...) NATIVE_LOG(ANDROID_LOG_ERROR, tag, __VA_ARGS__)
+
+#endif // NATIVE_LOG_HPP
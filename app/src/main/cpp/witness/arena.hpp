@@ -0,0 +1,97 @@
+#ifndef CIRCOM_ARENA_HPP
+#define CIRCOM_ARENA_HPP
+
+// 컴포넌트 배열용 bump allocator.
+// 생성 코드의 *_create 가 만드는 subcomponents / subcomponentsParallel / outputIsSet 을 여기서 할당하고,
+// 개별 해제 없이 witness 한 번이 끝나면 reset() 으로 한꺼번에 되돌린다.
+// 블록이 모자라 여러 개가 쓰였으면 reset() 때 전체 크기의 블록 하나로 합치므로, 같은 회로를 반복하면
+// 두 번째 witness 부터는 malloc 이 전혀 일어나지 않는다.
+// 소멸자를 호출하지 않으므로 trivially destructible 타입만 받는다 (mutex / thread 배열은 기존대로 new[]).
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <vector>
+#include <mutex>
+#include <type_traits>
+
+class Circom_Arena {
+public:
+    explicit Circom_Arena(size_t aBlockSize = 64 * 1024) : blockSize(aBlockSize), cur(0), used(0) {}
+
+    ~Circom_Arena() {
+        for (size_t i = 0; i < blocks.size(); i++) free(blocks[i].data);
+    }
+
+    // 0 으로 채운 T[n]. n == 0 이어도 유효한 포인터를 돌려준다 (new T[0] 과 같음)
+    template <typename T>
+    T *alloc(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destructed");
+        size_t size = sizeof(T) * n;
+        std::lock_guard<std::mutex> guard(lock);
+        char *p = bump(size, alignof(T));
+        memset(p, 0, size);
+        return (T *)p;
+    }
+
+    // 지금까지 할당한 것을 모두 버린다. 블록은 돌려주지 않고 다음 witness 에 재사용한다
+    void reset() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (blocks.size() > 1) {
+            size_t total = 0;
+            for (size_t i = 0; i < blocks.size(); i++) {
+                total += blocks[i].size;
+                free(blocks[i].data);
+            }
+            blocks.clear();
+            addBlock(total);
+        }
+        cur = 0;
+        used = 0;
+    }
+
+private:
+    struct Block {
+        char *data;
+        size_t size;
+    };
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    size_t cur;     // 현재 블록 번호
+    size_t used;    // 현재 블록에서 쓴 바이트
+    std::mutex lock;
+
+    void addBlock(size_t size) {
+        Block b;
+        b.data = (char *)malloc(size);
+        if (!b.data) throw std::bad_alloc();
+        b.size = size;
+        blocks.push_back(b);
+    }
+
+    char *bump(size_t size, size_t align) {
+        while (true) {
+            if (cur < blocks.size()) {
+                // malloc 블록은 16 바이트 정렬까지만 보장하므로 블록 안 위치가 아니라 주소를 정렬한다
+                uintptr_t base = (uintptr_t)blocks[cur].data;
+                size_t off = ((base + used + align - 1) & ~(uintptr_t)(align - 1)) - base;
+                if (off + size <= blocks[cur].size) {
+                    used = off + size;
+                    return blocks[cur].data + off;
+                }
+                if (cur + 1 < blocks.size()) {
+                    cur++;
+                    used = 0;
+                    continue;
+                }
+            }
+            addBlock(size + align > blockSize ? size + align : blockSize);
+            cur = blocks.size() - 1;
+            used = 0;
+        }
+    }
+};
+
+#endif // CIRCOM_ARENA_HPP
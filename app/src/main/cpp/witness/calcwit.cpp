@@ -2,14 +2,19 @@
 #include <sstream>
 #include <assert.h>
 #include <iostream>
+#include <new>
+#include <stdlib.h>
+#include <stdexcept>
+#include <algorithm>
 #include <pthread.h>
-#include <android/log.h> // 🔥 로그 헤더 추가
+#include "../native_log.hpp"
 #include "calcwit.hpp"
 
 // 🔥 디버깅 매크로 정의
 #define TAG "NativeCalcWit"
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, TAG, __VA_ARGS__)
+#define LOGV(...) NATIVE_LOGV(TAG, __VA_ARGS__)
+#define LOGD(...) NATIVE_LOGD(TAG, __VA_ARGS__)
+#define LOGE(...) NATIVE_LOGE(TAG, __VA_ARGS__)
 
 extern void run(Circom_CalcWit* ctx);
 
@@ -22,15 +27,37 @@ std::string int_to_hex( u64 i )
     return stream.str();
 }
 
-u64 fnv1a(std::string s) {
+u64 fnv1a(const char *s, size_t len) {
     u64 hash = 0xCBF29CE484222325LL;
-    for(char& c : s) {
-        hash ^= u64(c);
+    for (size_t i = 0; i < len; i++) {
+        hash ^= u64(s[i]);
         hash *= 0x100000001B3LL;
     }
     return hash;
 }
 
+void Circom_buildInputIndex(Circom_Circuit *circuit) {
+    uint n = get_size_of_input_hashmap();
+    uint count = 0;
+    for (uint i = 0; i < n; i++) {
+        if (circuit->InputHashMap[i].signalid != 0) count++;
+    }
+    circuit->inputIndex = new HashSignalInfo[count];
+    circuit->inputIndexSize = count;
+    count = 0;
+    for (uint i = 0; i < n; i++) {
+        if (circuit->InputHashMap[i].signalid != 0) circuit->inputIndex[count++] = circuit->InputHashMap[i];
+    }
+    std::sort(circuit->inputIndex, circuit->inputIndex + count,
+              [](const HashSignalInfo &a, const HashSignalInfo &b) { return a.hash < b.hash; });
+}
+
+void Circom_freeInputIndex(Circom_Circuit *circuit) {
+    delete [] circuit->inputIndex;
+    circuit->inputIndex = NULL;
+    circuit->inputIndexSize = 0;
+}
+
 Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
     LOGD("🚩 Constructor Start. Addr: %p", this); // 생성자 시작 로그
 
@@ -40,8 +67,19 @@ Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
     for (int i = 0; i< inputSignalAssignedCounter; i++) {
         inputSignalAssigned[i] = false;
     }
+#ifdef CIRCOM_PACKED_SIGNALS
+    void *limbs = nullptr;
+    if (posix_memalign(&limbs, sizeof(FrRawElement), sizeof(FrRawElement) * get_total_signal_no()) != 0) {
+        LOGE("❌ Signal store allocation failed");
+        throw std::bad_alloc();
+    }
+    signalLimbs = (FrRawElement *)limbs;
+#else
     signalValues = new FrElement[get_total_signal_no()];
-    Fr_str2element(&signalValues[0], "1", 10);
+#endif
+    FrElement one;
+    Fr_str2element(&one, "1", 10);
+    storeSignal(0, &one);
     componentMemory = new Circom_Component[get_number_of_components()];
     circuitConstants = circuit ->circuitConstants;
     templateInsId2IOSignalInfo = circuit -> templateInsId2IOSignalInfo;
@@ -49,18 +87,20 @@ Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
     listOfTemplateMessages = NULL;
 
     // 뮤텍스 초기화 및 로그
-    maxThread = maxTh;
+    maxThread = maxTh < 1 ? 1 : maxTh;
     numThread = 0;
     threads = new pthread_t[maxThread];
+    pool = maxThread > 1 ? new Circom_ThreadPool(maxThread) : nullptr;
+    parallelError = Fr_OK;
 
-    LOGD("🚩 Init Mutexes...");
+    LOGV("🚩 Init Mutexes...");
     int res1 = pthread_mutex_init(&mutex, NULL);
     int res2 = pthread_mutex_init(&processing, NULL);
 
     if (res1 != 0 || res2 != 0) {
         LOGE("❌ Mutex Init Failed! res1=%d, res2=%d", res1, res2);
     } else {
-        LOGD("✅ Mutex Init Success. mutex_addr=%p, processing_addr=%p", &mutex, &processing);
+        LOGV("✅ Mutex Init Success. mutex_addr=%p, processing_addr=%p", &mutex, &processing);
     }
 
     pthread_cond_init(&consumeSignal, NULL);
@@ -73,12 +113,18 @@ Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
 Circom_CalcWit::~Circom_CalcWit() {
     LOGD("💀 Destructor Called. Addr: %p", this); // 소멸자 로그
 
+    delete pool;
+    releaseMainComponent();
     delete [] inputSignalAssigned;
+#ifdef CIRCOM_PACKED_SIGNALS
+    free(signalLimbs);
+#else
     delete [] signalValues;
+#endif
     delete [] componentMemory;
     delete [] threads;
 
-    LOGD("💀 Destroying Mutexes...");
+    LOGV("💀 Destroying Mutexes...");
     pthread_mutex_destroy(&mutex);
     pthread_cond_destroy(&consumeSignal);
     pthread_cond_destroy(&produceSignal);
@@ -87,51 +133,74 @@ Circom_CalcWit::~Circom_CalcWit() {
     LOGD("💀 Destructor End");
 }
 
-uint Circom_CalcWit::getInputSignalHashPosition(u64 h) {
-    uint n = get_size_of_input_hashmap();
-    uint pos = (uint)(h % (u64)n);
-
-    if (circuit->InputHashMap[pos].hash != h) {
-        uint inipos = pos;
-        pos = (pos + 1) % n;
-
-        while (pos != inipos) {
-            if (circuit->InputHashMap[pos].hash == h) {
-                return pos;
-            }
-            if (circuit->InputHashMap[pos].signalid == 0) {
-                LOGE("Signal not found");
-                assert(false);
-            }
-            pos = (pos + 1) % n;
-        }
-        LOGE("Signals not found");
-        assert(false);
+// main 컴포넌트(0번)의 배열은 생성 코드의 release_memory_component 가 해제하지 않으므로 여기서 정리한다.
+// 나머지 컴포넌트는 실행 중에 이미 해제되었으므로 포인터만 비운다.
+// subcomponents / subcomponentsParallel / outputIsSet 은 componentArena 소속이라 따로 해제하지 않는다.
+void Circom_CalcWit::releaseMainComponent() {
+    Circom_Component &c = componentMemory[0];
+    delete [] c.mutexes;
+    delete [] c.cvs;
+    delete [] c.sbct;
+    uint n = get_number_of_components();
+    for (uint i = 0; i < n; i++) {
+        componentMemory[i].subcomponents = NULL;
+        componentMemory[i].subcomponentsParallel = NULL;
+        componentMemory[i].outputIsSet = NULL;
+        componentMemory[i].mutexes = NULL;
+        componentMemory[i].cvs = NULL;
+        componentMemory[i].sbct = NULL;
     }
-    return pos;
+}
+
+void Circom_CalcWit::reset() {
+    LOGD("♻️ reset. Addr: %p", this);
+    releaseMainComponent();
+    inputSignalAssignedCounter = get_main_input_signal_no();
+    memset(inputSignalAssigned, 0, sizeof(bool) * inputSignalAssignedCounter);
+    numThread = 0;
+    parallelError = Fr_OK;
+    componentArena.reset();
+    // signal 0 은 상수 1. 생성 코드가 덮어쓰지 않지만, 이전 실행이 중간에 실패했을 수도 있으므로 다시 쓴다
+    FrElement one;
+    Fr_str2element(&one, "1", 10);
+    storeSignal(0, &one);
+}
+
+const HashSignalInfo *Circom_CalcWit::requireInputSignal(u64 h) {
+    const HashSignalInfo *input = findInputSignal(h);
+    if (!input) {
+        LOGE("Signal not found: hash 0x%016llx", h);
+        throw std::runtime_error("Input signal not found");
+    }
+    return input;
 }
 
 void Circom_CalcWit::tryRunCircuit(){
-    // 로그 추가
-    LOGD("⚡ tryRunCircuit. Remaining: %d", inputSignalAssignedCounter);
+    LOGV("⚡ tryRunCircuit. Remaining: %u", inputSignalAssignedCounter.load());
 
     if (inputSignalAssignedCounter == 0) {
-        LOGD("⚡ Locking 'processing' mutex (%p)...", &processing);
+        LOGV("⚡ Locking 'processing' mutex (%p)...", &processing);
         pthread_mutex_lock(&processing);
-        LOGD("⚡ Locked 'processing'. numThread: %d", numThread);
+        LOGV("⚡ Locked 'processing'. numThread: %d", numThread);
 
-        if (numThread < maxThread) {
+        if (numThread == 0) {
             numThread++;
             pthread_mutex_unlock(&processing);
 
-            LOGD("⚡ Calling extern run(this)...");
+            LOGV("⚡ Calling extern run(this)...");
             // 🔥 여기가 가장 의심되는 지점 (circuit.cpp로 넘어가는 순간)
             run(this);
-            LOGD("⚡ Returned from run(this).");
+            if (parallelError != Fr_OK) Fr_setError(parallelError);
+            LOGV("⚡ Returned from run(this).");
+
+            pthread_mutex_lock(&processing);
+            numThread--;
+            pthread_cond_broadcast(&processingReady);
+            pthread_mutex_unlock(&processing);
 
         } else {
             pthread_mutex_unlock(&processing);
-            LOGD("⚡ Threads full, unlocked 'processing'.");
+            LOGV("⚡ Threads full, unlocked 'processing'.");
         }
     }
 }
@@ -147,22 +216,27 @@ void Circom_CalcWit::setInputSignal(u64 h, uint i,  FrElement & val){
         return;
     }
 
-    uint pos = getInputSignalHashPosition(h);
-    if (i >= circuit->InputHashMap[pos].signalsize) {
+    const HashSignalInfo *input = findInputSignal(h);
+    if (!input) {
+        pthread_mutex_unlock(&mutex);
+        LOGE("Signal not found");
+        throw std::runtime_error("Signal not found");
+    }
+    if (i >= input->signalsize) {
         pthread_mutex_unlock(&mutex);
         LOGE("Input signal array access exceeds the size");
-        assert(false);
+        throw std::runtime_error("Input signal array access exceeds the size");
     }
 
-    uint si = circuit->InputHashMap[pos].signalid + i;
-    if (inputSignalAssigned[si - get_main_input_signal_start()]) {
+    uint si = input->signalid + i;
+    // setInputSignals 는 잠금 없이 표시하므로 여기서도 원자적으로 차지한다
+    if (__atomic_exchange_n(&inputSignalAssigned[si - get_main_input_signal_start()], true, __ATOMIC_ACQ_REL)) {
         pthread_mutex_unlock(&mutex);
         LOGE("Signal assigned twice: %d", si);
-        assert(false);
+        throw std::runtime_error("Signal assigned twice");
     }
 
-    signalValues[si] = val;
-    inputSignalAssigned[si - get_main_input_signal_start()] = true;
+    storeSignal(si, &val);
     inputSignalAssignedCounter--;
 
     pthread_cond_signal(&produceSignal);
@@ -171,32 +245,92 @@ void Circom_CalcWit::setInputSignal(u64 h, uint i,  FrElement & val){
     tryRunCircuit();
 }
 
+void Circom_CalcWit::setInputSignals(u64 h, const FrElement *vals, uint n) {
+    setInputSignals(requireInputSignal(h), vals, n);
+}
+
+void Circom_CalcWit::setInputSignals(const HashSignalInfo *input, const FrElement *vals, uint n) {
+    if (n != input->signalsize) {
+        LOGE("Input signal size mismatch: got %u, expected %llu", n, input->signalsize);
+        throw std::runtime_error("Input signal size mismatch");
+    }
+
+    // 원소마다 표시를 원자적으로 차지한다. 같은 신호를 두 스레드가 넣으면 한쪽만 차지하고 다른 쪽은 예외를 던진다.
+    // 이미 넣은 원소를 만나면 이번 호출이 차지한 것만 되돌린다 (그 원소들의 값은 아직 쓰지 않았다)
+    uint si = input->signalid;
+    bool *assigned = &inputSignalAssigned[si - get_main_input_signal_start()];
+    for (uint i = 0; i < n; i++) {
+        if (__atomic_exchange_n(&assigned[i], true, __ATOMIC_ACQ_REL)) {
+            for (uint j = 0; j < i; j++) __atomic_store_n(&assigned[j], false, __ATOMIC_RELEASE);
+            LOGE("Signal assigned twice: %u", si + i);
+            throw std::runtime_error("Signal assigned twice");
+        }
+    }
+
+    for (uint i = 0; i < n; i++) {
+        storeSignal(si + i, (PFrElement)&vals[i]);
+    }
+
+    if (inputSignalAssignedCounter.fetch_sub(n) == n) {
+        tryRunCircuit();
+    }
+}
+
 void Circom_CalcWit::join() {
-    LOGD("⏳ Join called. Locking 'processing'...");
+    LOGV("⏳ Join called. Locking 'processing'...");
     pthread_mutex_lock(&processing);
     while (numThread > 0) {
-        LOGD("⏳ Waiting for threads...");
+        LOGV("⏳ Waiting for threads...");
         pthread_cond_wait(&processingReady, &processing);
     }
     pthread_mutex_unlock(&processing);
-    LOGD("✅ Join finished.");
+    LOGV("✅ Join finished.");
+}
+
+void Circom_CalcWit::spawnParallel(Circom_TaskFunction fn, uint cIdx) {
+    Circom_Task task = {fn, cIdx, this};
+    __atomic_store_n(&componentMemory[cIdx].parallelDone, 0, __ATOMIC_RELAXED);
+    if (pool) pool->submit(task);
+    else runParallelTask(task);
+}
+
+// 풀 스레드 (또는 기다리던 스레드가 대신) 에서 컴포넌트 하나를 실행한다.
+// Fr 오류 채널은 스레드별이므로, 실행 중 난 오류는 parallelError 로 모으고 이 스레드의 이전 상태는 되돌린다.
+void Circom_CalcWit::runParallelTask(const Circom_Task &task) {
+    int saved = Fr_getError();
+    Fr_clearError();
+    task.fn(task.cIdx, task.ctx);
+    int err = Fr_getError();
+    if (err != Fr_OK) {
+        int expected = Fr_OK;
+        parallelError.compare_exchange_strong(expected, err);
+    }
+    Fr_setError(saved);
+    __atomic_store_n(&componentMemory[task.cIdx].parallelDone, 1, __ATOMIC_RELEASE);
+    if (pool) pool->notifyWaiters();
 }
 
 u64 Circom_CalcWit::getInputSignalSize(u64 h) {
-    uint pos = getInputSignalHashPosition(h);
-    return circuit->InputHashMap[pos].signalsize;
+    return requireInputSignal(h)->signalsize;
+}
+
+std::string Circom_CalcWit::getComponentName(u64 id_cmp){
+    const Circom_Component &c = componentMemory[id_cmp];
+    std::string name = c.componentName ? c.componentName : "";
+    if (c.nameDims) name += generate_position_array(c.nameDims, c.nameDimsSize, c.nameIndex);
+    return name;
 }
 
 std::string Circom_CalcWit::getTrace(u64 id_cmp){
-    if (id_cmp == 0) return componentMemory[id_cmp].componentName;
+    if (id_cmp == 0) return getComponentName(id_cmp);
     else{
         u64 id_father = componentMemory[id_cmp].idFather;
-        std::string my_name = componentMemory[id_cmp].componentName;
+        std::string my_name = getComponentName(id_cmp);
         return Circom_CalcWit::getTrace(id_father) + "." + my_name;
     }
 }
 
-std::string Circom_CalcWit::generate_position_array(uint* dimensions, uint size_dimensions, uint index){
+std::string Circom_CalcWit::generate_position_array(const uint* dimensions, uint size_dimensions, uint index){
     std::string positions = "";
     for (uint i = 0 ; i < size_dimensions; i++){
         uint last_pos = index % dimensions[size_dimensions -1 - i];
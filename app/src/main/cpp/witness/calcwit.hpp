@@ -3,20 +3,38 @@
 
 #include <vector>
 #include <string>
+#include <string.h>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <pthread.h>
 #include "circom.hpp"
 #include "fr.hpp" // FrElement 정의 필요
+#include "arena.hpp"
+#include "threadpool.hpp"
 
 // native-witness.cpp에서 사용하므로 외부 공개
-u64 fnv1a(std::string s);
+u64 fnv1a(const char *s, size_t len);
+inline u64 fnv1a(const std::string &s) {
+    return fnv1a(s.data(), s.size());
+}
+
+// 입력 신호 조회용 정렬 색인을 만든다 (loadCircuit 에서 한 번)
+void Circom_buildInputIndex(Circom_Circuit *circuit);
+void Circom_freeInputIndex(Circom_Circuit *circuit);
+
+// CIRCOM_PACKED_SIGNALS: 신호를 40바이트 FrElement 대신 32바이트 정렬된 Montgomery limb 4개로 저장한다.
+// Montgomery 값은 q < 2^254 이므로 최상위 비트는 항상 0 이고, 이 비트를 short 값 표시로 쓴다
+// (short 이면 limb[0] 하위 32비트가 int32 값). 별도 비트맵이 없어 스레드 간 공유 쓰기도 없다.
+#define CIRCOM_SIGNAL_SHORT_TAG (1ULL << 63)
 
 class Circom_CalcWit {
 public:
     Circom_Circuit *circuit;
-    uint maxThread;
-    uint numThread;
+    uint maxThread;     // 병렬 컴포넌트를 실행할 스레드 수 (호출 스레드 포함). 1 이면 풀 없이 순서대로 실행
+    uint numThread;     // 실행 중인 run() 수 (0 또는 1)
+    Circom_ThreadPool *pool;
+    std::atomic<int> parallelError;  // 풀 스레드에서 난 첫 Fr 오류. run() 이 끝나면 호출 스레드로 옮긴다
 
     // 🔥 [핵심] pthread 직접 사용 (SIGABRT 방지)
     pthread_t* threads;
@@ -27,9 +45,15 @@ public:
     pthread_cond_t processingReady;
 
     bool* inputSignalAssigned;
-    uint inputSignalAssignedCounter;
+    std::atomic<uint> inputSignalAssignedCounter;
+#ifdef CIRCOM_PACKED_SIGNALS
+    FrRawElement* signalLimbs;
+#else
     FrElement* signalValues;
+#endif
     Circom_Component* componentMemory;
+    // 컴포넌트별 배열 (subcomponents 등). reset() 에서 한 번에 비운다
+    Circom_Arena componentArena;
     FrElement* circuitConstants;
     std::map<u32,IOFieldDefPair> templateInsId2IOSignalInfo;
 
@@ -42,22 +66,125 @@ public:
     Circom_CalcWit(Circom_Circuit *aCircuit, uint maxTh = 1);
     ~Circom_CalcWit();
 
+    // 같은 회로로 witness 를 다시 계산할 수 있게 입력 표시/카운터와 componentArena 를 되돌린다.
+    // 신호 배열과 컴포넌트 메모리는 재할당하지 않는다 (모든 신호는 읽기 전에 다시 쓰인다).
+    void reset();
+    void releaseMainComponent();
+
     void setInputSignal(u64 h, uint i, FrElement & val);
+    // 입력 신호 하나(배열 전체)를 한 번에 넣는다. 해시는 한 번만 찾고 원소별 표시를 원자적으로 차지한 뒤
+    // 잠금 없이 복사하고 남은 입력 수를 원자적으로 줄이며, 마지막 입력을 넣은 호출만 회로를 실행한다.
+    // n 은 신호 크기와 같아야 하고, 여러 스레드에서 동시에 넣어도 된다 (같은 신호가 겹치면 한쪽만 성공하고 나머지는 예외).
+    void setInputSignals(u64 h, const FrElement *vals, uint n);
+    void setInputSignals(const HashSignalInfo *input, const FrElement *vals, uint n);
     void tryRunCircuit();
     void join();
 
-    uint getInputSignalHashPosition(u64 h);
+    // 병렬 컴포넌트 실행. circom 이 std::thread 로 만들던 부분을 대신한다:
+    //   std::thread(X_run_parallel, idx, ctx)     -> ctx->spawnParallel(X_run_parallel, idx)
+    //   sbct[i].join()                            -> ctx->waitComponent(idx)
+    //   lock_guard + outputIsSet[o] = true + notify -> ctx->setOutputReady(idx, o)
+    //   unique_lock + cvs[o].wait(outputIsSet[o])  -> ctx->waitOutput(idx, o)
+    // 출력 준비 표시는 잠금 없이 acquire/release 로 주고받고, 기다리는 동안에는 풀의 다른 작업을 실행하다가
+    // 할 일이 없으면 잠깐 양보한 뒤 잠든다 (Circom_ThreadPool::helpUntil).
+    void spawnParallel(Circom_TaskFunction fn, uint cIdx);
+    void runParallelTask(const Circom_Task &task);
+
+    inline void setOutputReady(uint cIdx, uint out) {
+        __atomic_store_n(&componentMemory[cIdx].outputIsSet[out], true, __ATOMIC_RELEASE);
+        if (pool) pool->notifyWaiters();
+    }
+
+    inline void waitOutput(uint cIdx, uint out) {
+        waitUntil([this, cIdx, out]() {
+            return __atomic_load_n(&componentMemory[cIdx].outputIsSet[out], __ATOMIC_ACQUIRE);
+        });
+    }
+
+    inline void waitComponent(uint cIdx) {
+        waitUntil([this, cIdx]() { return __atomic_load_n(&componentMemory[cIdx].parallelDone, __ATOMIC_ACQUIRE) != 0; });
+    }
+
+    // 풀이 없으면 spawnParallel 이 그 자리에서 실행하므로 기다릴 일이 없다
+    template <typename Ready>
+    inline void waitUntil(Ready ready) {
+        if (pool) pool->helpUntil(ready);
+        else while (!ready()) std::this_thread::yield();
+    }
+
+    // 입력 이름 → (signalid, signalsize). 반환 포인터는 회로가 살아 있는 동안 유효하므로
+    // 한 번 찾아 두고 여러 witness 에 걸쳐 setInputSignals 에 그대로 넘길 수 있다. 없으면 NULL
+    inline const HashSignalInfo *resolveInput(const std::string &name) {
+        return findInputSignal(fnv1a(name));
+    }
+
+    // 정렬 색인에서 분기 없는 이진 탐색
+    inline const HashSignalInfo *findInputSignal(u64 h) {
+        const HashSignalInfo *base = circuit->inputIndex;
+        uint n = circuit->inputIndexSize;
+        if (n == 0) return NULL;
+        while (n > 1) {
+            uint half = n / 2;
+            base = (base[half].hash <= h) ? base + half : base;
+            n -= half;
+        }
+        return base->hash == h ? base : NULL;
+    }
+
+    const HashSignalInfo *requireInputSignal(u64 h);
     u64 getInputSignalSize(u64 h);
     std::string getTrace(u64 id_cmp);
-    std::string generate_position_array(uint* dimensions, uint size_dimensions, uint index);
+    std::string getComponentName(u64 id_cmp);
+    std::string generate_position_array(const uint* dimensions, uint size_dimensions, uint index);
+
+    // 컴포넌트 배열 원소의 위치를 기록한다 (이름 문자열은 getTrace 때만 만든다). dims 는 정적 저장소여야 한다
+    inline void setComponentPosition(u64 id_cmp, const uint *dims, uint size_dims, uint index) {
+        componentMemory[id_cmp].nameDims = dims;
+        componentMemory[id_cmp].nameDimsSize = size_dims;
+        componentMemory[id_cmp].nameIndex = index;
+    }
 
     // 🔥 [복구] native-witness.cpp 및 JNI에서 사용하는 인라인 함수들
     inline uint getRemaingInputsToBeSet() {
         return inputSignalAssignedCounter;
     }
 
-    inline void getWitness(uint idx, PFrElement val) {
-        Fr_copy(val, &signalValues[circuit->witness2SignalList[idx]]);
+    // 생성 코드의 신호 접근 (circom 출력의 signalValues[i] 접근은 circom_postprocess.py 가 이 둘로 바꾼다).
+    // loadSignal 은 값을 가리키는 포인터를 돌려준다:
+    // 기본 모드는 저장소 안을 직접 가리키고 tmp 는 쓰지 않으며, packed 모드는 tmp 에 풀어서 돌려준다.
+    inline PFrElement loadSignal(u64 i, PFrElement tmp) {
+#ifdef CIRCOM_PACKED_SIGNALS
+        const uint64_t *v = signalLimbs[i];
+        if (v[3] & CIRCOM_SIGNAL_SHORT_TAG) {
+            tmp->shortVal = (int32_t)v[0];
+            tmp->type = Fr_SHORT;
+        } else {
+            tmp->shortVal = 0;
+            tmp->type = Fr_LONGMONTGOMERY;
+            memcpy(tmp->longVal, v, sizeof(FrRawElement));
+        }
+        return tmp;
+#else
+        return &signalValues[i];
+#endif
+    }
+
+    inline void storeSignal(u64 i, PFrElement a) {
+#ifdef CIRCOM_PACKED_SIGNALS
+        uint64_t *v = signalLimbs[i];
+        if (!(a->type & Fr_LONG)) {
+            v[0] = (uint32_t)a->shortVal;
+            v[1] = 0;
+            v[2] = 0;
+            v[3] = CIRCOM_SIGNAL_SHORT_TAG;
+        } else if (a->type == Fr_LONGMONTGOMERY) {
+            memcpy(v, a->longVal, sizeof(FrRawElement));
+        } else {
+            Fr_rawToMontgomery(v, a->longVal);
+        }
+#else
+        Fr_copy(&signalValues[i], a);
+#endif
     }
 };
 
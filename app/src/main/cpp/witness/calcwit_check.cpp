@@ -0,0 +1,354 @@
+// Circom_CalcWit 런타임 검사 (WITNESS_BUILD_TESTS=ON 일 때만 빌드, ctest 로 실행)
+// 실제 회로 대신 이 파일이 작은 합성 회로를 정의한다 (circom.hpp 의 get_* / run 을 직접 제공):
+//   Fan (main) 이 Child 64 개를 spawnParallel 로 띄우고, Child 는 각각 Leaf 2 개를 띄운다.
+//   Leaf l 의 출력은 (in + l)^(2^LEAF_ROUNDS), Child 는 두 Leaf 의 합, Fan 은 Child 출력의 합이다.
+//   Fan 은 자식을 띄운 뒤 잠깐 멈춰 작업 스레드가 큐 앞의 Child 0 을 훔쳐 가게 하고, Leaf 0 은 실행 중에 잠든다.
+//   그러면 Fan 은 나머지를 직접 실행한 뒤 다른 스레드의 Child 0 을 기다리며 helpUntil 에서 잠들어야 한다.
+// 스레드 수를 바꿔 가며 결과를 mpz 로 계산한 값과 비교하고, Leaf 에서 난 Fr 오류가 호출 스레드로 오는지 본다.
+// 같은 입력을 여러 스레드가 동시에 넣을 때 한 번만 받아들이는지,
+// Circom_Arena (정렬, 0 채우기, reset 때 블록 합치기) 와 입력 색인 (findInputSignal / resolveInput) 도 따로 검사한다.
+// 사용법: calcwit-check   (기기에서는 adb push 후 실행)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gmp.h>
+#include "arena.hpp"
+#include "calcwit.hpp"
+#include "circom.hpp"
+
+static int failures = 0;
+static long checks = 0;
+
+#define CHECK(cond, ...) do { \
+        checks++; \
+        if (!(cond)) { \
+            if (failures++ < 30) { printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } \
+        } \
+    } while (0)
+
+// ---- 합성 회로 ----
+
+#define CHILDREN 64
+#define LEAVES (2 * CHILDREN)
+#define LEAF_ROUNDS 200
+#define SLOW_LEAF_MS 20
+// 이 입력이면 Leaf ERROR_LEAF 가 0 으로 나눈다 (오류 전달 검사)
+#define ERROR_INPUT 0
+#define ERROR_LEAF 77
+
+// 신호: 0 = 1, 1 = out, 2 = in, 3.. = Child 출력, 3 + CHILDREN.. = Leaf 출력
+#define SIG_OUT 1
+#define SIG_IN 2
+#define SIG_CHILD 3
+#define SIG_LEAF (SIG_CHILD + CHILDREN)
+#define SIGNALS (SIG_LEAF + LEAVES)
+// 컴포넌트: 0 = Fan, 1.. = Child, 1 + CHILDREN.. = Leaf
+#define CMP_CHILD 1
+#define CMP_LEAF (CMP_CHILD + CHILDREN)
+#define COMPONENTS (CMP_LEAF + LEAVES)
+#define INPUT_HASHMAP 256
+
+static const char *templateNames[] = {"Fan", "Child", "Leaf"};
+
+uint get_main_input_signal_start() {return SIG_IN;}
+uint get_main_input_signal_no() {return 1;}
+uint get_total_signal_no() {return SIGNALS;}
+uint get_number_of_components() {return COMPONENTS;}
+uint get_size_of_input_hashmap() {return INPUT_HASHMAP;}
+uint get_size_of_witness() {return SIGNALS;}
+uint get_size_of_constants() {return 0;}
+uint get_size_of_io_map() {return 0;}
+uint get_size_of_bus_field_map() {return 0;}
+uint get_number_of_templates() {return 3;}
+const char *get_template_name(uint templateId) {return templateNames[templateId];}
+
+static void initComponent(Circom_CalcWit *ctx, uint cIdx, uint templateId, uint father, uint outputs) {
+    Circom_Component &c = ctx->componentMemory[cIdx];
+    c.templateId = templateId;
+    c.idFather = father;
+    c.componentName = templateNames[templateId];
+    c.outputIsSet = ctx->componentArena.alloc<bool>(outputs);
+}
+
+static void Leaf_run(uint cIdx, Circom_CalcWit *ctx) {
+    uint l = cIdx - CMP_LEAF;
+    FrElement sigaux[1], v, k;
+    Fr_str2element(&k, std::to_string(l).c_str(), 10);
+    Fr_add(&v, ctx->loadSignal(SIG_IN, &sigaux[0]), &k);
+    for (int i = 0; i < LEAF_ROUNDS; i++) Fr_square(&v, &v);
+    if (l == 0) std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_LEAF_MS));
+    if (l == ERROR_LEAF) {
+        FrElement in = *ctx->loadSignal(SIG_IN, &sigaux[0]);
+        Fr_div(&k, &v, &in);
+    }
+    ctx->storeSignal(SIG_LEAF + l, &v);
+    ctx->setOutputReady(cIdx, 0);
+}
+
+static void Child_run(uint cIdx, Circom_CalcWit *ctx) {
+    uint i = cIdx - CMP_CHILD;
+    uint leaves[2] = {CMP_LEAF + 2 * i, CMP_LEAF + 2 * i + 1};
+    for (uint leaf : leaves) {
+        initComponent(ctx, leaf, 2, cIdx, 1);
+        ctx->spawnParallel(Leaf_run, leaf);
+    }
+    FrElement sigaux[2], sum;
+    for (uint leaf : leaves) ctx->waitComponent(leaf);
+    Fr_add(&sum, ctx->loadSignal(SIG_LEAF + 2 * i, &sigaux[0]), ctx->loadSignal(SIG_LEAF + 2 * i + 1, &sigaux[1]));
+    ctx->storeSignal(SIG_CHILD + i, &sum);
+    ctx->setOutputReady(cIdx, 0);
+}
+
+void run(Circom_CalcWit *ctx) {
+    initComponent(ctx, 0, 0, 0, 1);
+    for (uint i = 0; i < CHILDREN; i++) {
+        initComponent(ctx, CMP_CHILD + i, 1, 0, 1);
+        ctx->spawnParallel(Child_run, CMP_CHILD + i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    // 출력은 나중에 띄운 자식부터 기다려 waitOutput 이 실제로 기다리게 한다
+    FrElement sigaux[1], sum = {0, Fr_SHORT};
+    for (uint i = CHILDREN; i-- > 0;) {
+        ctx->waitOutput(CMP_CHILD + i, 0);
+        Fr_add(&sum, &sum, ctx->loadSignal(SIG_CHILD + i, &sigaux[0]));
+    }
+    for (uint i = 0; i < CHILDREN; i++) ctx->waitComponent(CMP_CHILD + i);
+    ctx->storeSignal(SIG_OUT, &sum);
+}
+
+// ---- 기준 값 ----
+
+static std::string expected(int in) {
+    mpz_t q, v, e, sum;
+    mpz_init_set_str(q, "21888242871839275222246405745257275088548364400416034343698204186575808495617", 10);
+    mpz_init(v); mpz_init(e); mpz_init_set_ui(sum, 0);
+    mpz_ui_pow_ui(e, 2, LEAF_ROUNDS);
+    for (int l = 0; l < LEAVES; l++) {
+        mpz_set_si(v, in + l);
+        mpz_mod(v, v, q);
+        mpz_powm(v, v, e, q);
+        mpz_add(sum, sum, v);
+    }
+    mpz_mod(sum, sum, q);
+    char *s = mpz_get_str(nullptr, 10, sum);
+    std::string r(s);
+    free(s);
+    mpz_clear(q); mpz_clear(v); mpz_clear(e); mpz_clear(sum);
+    return r;
+}
+
+static std::string signalString(Circom_CalcWit *ctx, u64 i) {
+    FrElement tmp;
+    char *s = Fr_element2str(ctx->loadSignal(i, &tmp));
+    std::string r(s);
+    free(s);
+    return r;
+}
+
+static void setInput(Circom_CalcWit *ctx, int in) {
+    FrElement v;
+    Fr_str2element(&v, std::to_string(in).c_str(), 10);
+    ctx->setInputSignals(ctx->resolveInput("in"), &v, 1);
+}
+
+// 같은 ctx 로 reset() 해 가며 여러 번 계산한다. 오류 입력 뒤에도 정상 입력이 맞아야 한다
+static void checkPool(Circom_Circuit *circuit, uint threads) {
+    Circom_CalcWit *ctx = new Circom_CalcWit(circuit, threads);
+    const int inputs[] = {5, ERROR_INPUT, 123456789, 5};
+    bool first = true;
+    for (int in : inputs) {
+        if (!first) ctx->reset();
+        first = false;
+        Fr_clearError();
+        try {
+            setInput(ctx, in);
+        } catch (const std::exception &e) {
+            CHECK(false, "[%u threads] in=%d: %s", threads, in, e.what());
+            continue;
+        }
+        int err = Fr_getError();
+        if (in == ERROR_INPUT) {
+            CHECK(err == Fr_ERR_DIV_BY_ZERO, "[%u threads] leaf error not propagated (error %d)", threads, err);
+        } else {
+            CHECK(err == Fr_OK, "[%u threads] in=%d: error %d", threads, in, err);
+        }
+        CHECK(signalString(ctx, SIG_OUT) == expected(in), "[%u threads] in=%d: out %s, want %s",
+              threads, in, signalString(ctx, SIG_OUT).c_str(), expected(in).c_str());
+        for (uint c = 0; c < COMPONENTS; c++) {
+            if (c == 0) continue;
+            CHECK(__atomic_load_n(&ctx->componentMemory[c].parallelDone, __ATOMIC_ACQUIRE) == 1,
+                  "[%u threads] in=%d: component %u not done", threads, in, c);
+        }
+    }
+    Fr_clearError();
+    delete ctx;
+}
+
+// 여러 스레드가 같은 입력을 동시에 넣으면 정확히 한 호출만 성공해 회로를 실행하고 나머지는 예외를 받아야 한다
+static void checkConcurrentInput(Circom_Circuit *circuit) {
+    const int setters = 8;
+    Circom_CalcWit *ctx = new Circom_CalcWit(circuit, 2);
+    for (int rep = 0; rep < 20; rep++) {
+        if (rep) ctx->reset();
+        std::atomic<int> ok(0), twice(0), go(0);
+        std::vector<std::thread> ts;
+        for (int t = 0; t < setters; t++) {
+            ts.emplace_back([&]() {
+                go++;
+                while (go.load() < setters) std::this_thread::yield();
+                try {
+                    setInput(ctx, 5);
+                    ok++;
+                } catch (const std::runtime_error &) {
+                    twice++;
+                }
+            });
+        }
+        for (auto &t : ts) t.join();
+        CHECK(ok == 1 && twice == setters - 1, "concurrent input rep %d: %d succeeded, %d rejected", rep, ok.load(), twice.load());
+        CHECK(signalString(ctx, SIG_OUT) == expected(5), "concurrent input rep %d: wrong out", rep);
+    }
+    delete ctx;
+}
+
+// ---- Circom_Arena ----
+
+struct Wide {
+    alignas(32) uint64_t v[4];
+};
+
+static void checkArena() {
+    // 블록이 작아 첫 witness 는 여러 블록에 걸친다
+    Circom_Arena arena(256);
+    const size_t sizes[] = {1, 0, 3, 40, 7, 100, 1, 300, 64, 5, 2, 1000, 9, 33};
+    const int N = sizeof(sizes) / sizeof(sizes[0]);
+    for (int round = 0; round < 3; round++) {
+        if (round > 0) arena.reset();
+        char *prev = NULL;
+        char *first = NULL;
+        size_t total = 0;   // 요청한 바이트 + 정렬로 생길 수 있는 틈
+        for (int rep = 0; rep < 4; rep++) {
+            for (int i = 0; i < N; i++) {
+                size_t n = sizes[i];
+                char *p;
+                switch (i % 4) {
+                case 0: {
+                    bool *b = arena.alloc<bool>(n);
+                    for (size_t k = 0; k < n; k++) CHECK(!b[k], "round %d: bool[%zu] not zero", round, k);
+                    p = (char *)b;
+                    break;
+                }
+                case 1: {
+                    uint *u = arena.alloc<uint>(n);
+                    CHECK((uintptr_t)u % alignof(uint) == 0, "round %d: uint misaligned", round);
+                    for (size_t k = 0; k < n; k++) CHECK(u[k] == 0, "round %d: uint[%zu] not zero", round, k);
+                    p = (char *)u;
+                    break;
+                }
+                case 2: {
+                    FrElement *e = arena.alloc<FrElement>(n);
+                    CHECK((uintptr_t)e % alignof(FrElement) == 0, "round %d: FrElement misaligned", round);
+                    p = (char *)e;
+                    break;
+                }
+                default: {
+                    Wide *w = arena.alloc<Wide>(n);
+                    CHECK((uintptr_t)w % alignof(Wide) == 0, "round %d: 32-byte type misaligned", round);
+                    p = (char *)w;
+                    break;
+                }
+                }
+                CHECK(p != NULL, "round %d: alloc(%zu) returned NULL", round, n);
+                n *= i % 4 == 0 ? sizeof(bool) : i % 4 == 1 ? sizeof(uint) : i % 4 == 2 ? sizeof(FrElement) : sizeof(Wide);
+                total += n + alignof(Wide);
+                for (size_t k = 0; k < n; k++) CHECK(p[k] == 0, "round %d: byte %zu not zero", round, k);
+                // 다음 round 에서 0 으로 다시 채워지는지 보려고 더럽힌다
+                memset(p, 0xA5, n);
+                // 두 번째 round 부터는 reset 이 합친 블록 하나에서 차례로 나와야 한다
+                if (round > 0) {
+                    if (!first) first = p;
+                    CHECK(prev == NULL || p >= prev, "round %d: allocation went back to an earlier block", round);
+                    prev = p + n;
+                }
+            }
+        }
+        if (round > 0) CHECK((size_t)(prev - first) <= total, "round %d: allocations not contiguous", round);
+    }
+}
+
+// ---- 입력 색인 ----
+
+// 0 ~ 60 개의 입력을 InputHashMap 의 무작위 칸에 넣고 색인을 만들어, 모든 입력을 찾고 없는 해시는 NULL 인지 본다
+static void checkInputIndex(std::mt19937_64 &rng) {
+    for (int keys = 0; keys <= 60; keys++) {
+        Circom_Circuit *circuit = new Circom_Circuit();
+        circuit->InputHashMap = new HashSignalInfo[INPUT_HASHMAP]();
+        std::vector<std::string> names;
+        std::set<u64> hashes;
+        std::vector<uint> slots;
+        for (uint i = 0; i < INPUT_HASHMAP; i++) slots.push_back(i);
+        std::shuffle(slots.begin(), slots.end(), rng);
+        for (int k = 0; k < keys; k++) {
+            std::string name = "in" + std::to_string(rng() % 1000000) + "_" + std::to_string(k);
+            names.push_back(name);
+            hashes.insert(fnv1a(name));
+            circuit->InputHashMap[slots[k]] = HashSignalInfo{fnv1a(name), 1 + (u64)k * 7, 1 + rng() % 16};
+        }
+        Circom_buildInputIndex(circuit);
+        CHECK(circuit->inputIndexSize == (uint)keys, "%d keys: index has %u entries", keys, circuit->inputIndexSize);
+
+        Circom_CalcWit *ctx = new Circom_CalcWit(circuit, 1);
+        for (int k = 0; k < keys; k++) {
+            const HashSignalInfo *want = &circuit->InputHashMap[slots[k]];
+            const HashSignalInfo *got = ctx->resolveInput(names[k]);
+            CHECK(got && got->hash == want->hash && got->signalid == want->signalid && got->signalsize == want->signalsize,
+                  "%d keys: %s not found", keys, names[k].c_str());
+            CHECK(ctx->findInputSignal(want->hash) == got, "%d keys: findInputSignal differs from resolveInput", keys);
+        }
+        // 없는 해시: 양 끝, 0, 최대값, 있는 해시의 이웃, 무작위
+        std::vector<u64> misses = {0, ~0ULL, 1, ~0ULL - 1};
+        for (u64 h : hashes) { misses.push_back(h - 1); misses.push_back(h + 1); }
+        for (int i = 0; i < 200; i++) misses.push_back(rng());
+        for (u64 h : misses) {
+            if (hashes.count(h)) continue;
+            CHECK(ctx->findInputSignal(h) == NULL, "%d keys: hash %016llx found but not present", keys, h);
+        }
+        CHECK(ctx->resolveInput("not_an_input") == NULL, "%d keys: unknown name resolved", keys);
+        delete ctx;
+
+        Circom_freeInputIndex(circuit);
+        delete [] circuit->InputHashMap;
+        delete circuit;
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(0x5eed);
+    checkArena();
+    checkInputIndex(rng);
+
+    Circom_Circuit *circuit = new Circom_Circuit();
+    circuit->InputHashMap = new HashSignalInfo[INPUT_HASHMAP]();
+    circuit->InputHashMap[7] = HashSignalInfo{fnv1a("in"), SIG_IN, 1};
+    Circom_buildInputIndex(circuit);
+
+    for (uint threads : {1u, 2u, 4u, 8u}) {
+        for (int rep = 0; rep < 3; rep++) checkPool(circuit, threads);
+    }
+    checkConcurrentInput(circuit);
+
+    Circom_freeInputIndex(circuit);
+    delete [] circuit->InputHashMap;
+    delete circuit;
+    printf("calcwit-check: %ld checks, %d failures\n", checks, failures);
+    return failures ? 1 : 0;
+}
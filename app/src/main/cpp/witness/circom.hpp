@@ -2,12 +2,16 @@
 #define __CIRCOM_H
 
 #include <map>
+#include <vector>
 #include <gmp.h>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <type_traits>
 
 #include "fr.hpp"
+#include "mappedfile.hpp"
+#include "datfile.hpp"
 
 typedef unsigned long long u64;
 typedef uint32_t u32;
@@ -35,29 +39,45 @@ struct IOFieldDefPair {
 
 struct Circom_Circuit {
   //  const char *P;
-  HashSignalInfo* InputHashMap;
-  u64* witness2SignalList;
-  FrElement* circuitConstants;  
+  HashSignalInfo* InputHashMap = NULL;
+  // InputHashMap 의 유효한 항목만 hash 순으로 정렬한 사본 (Circom_buildInputIndex 가 로드 때 만든다)
+  HashSignalInfo* inputIndex = NULL;
+  uint inputIndexSize = 0;
+  // witness 번호 -> 신호 번호 표를 run 으로 (datfile.hpp). .dat 이 u64 목록이면 로드 때 run 으로 바꾼다
+  std::vector<Circom_WitnessRun> witnessRuns;
+  FrElement* circuitConstants = NULL;
+  // zero-copy 로드면 InputHashMap / circuitConstants 는 datFile 매핑 안을 가리키는 읽기 전용 포인터이고, 해제는 매핑이 한다
+  Circom_MappedFile datFile;
+  Circom_DatContainer dat;  // datFile 의 구간 표와 구간별 checksum 검사 상태
+  bool dataMapped = false;
   std::map<u32,IOFieldDefPair> templateInsId2IOSignalInfo;
   IOFieldDefPair* busInsId2FieldInfo;
 };
 
 
+// 컴포넌트 기술자는 문자열을 소유하지 않는다 (trivially copyable).
+// 템플릿 이름은 templateId 로 get_template_name() 에서 찾고, 컴포넌트 이름은 정적 문자열 리터럴을 가리킨다.
+// 컴포넌트 배열의 원소는 nameDims / nameIndex 를 남겨 두고, "[i][j]" 는 getTrace() 가 필요할 때만 만든다.
 struct Circom_Component {
   u32 templateId;
-  u64 signalStart;
   u32 inputCounter;
-  std::string templateName;
-  std::string componentName;
-  u64 idFather; 
+  u64 signalStart;
+  u64 idFather;
+  const char *componentName = NULL;
+  const uint *nameDims = NULL;  // 정적 저장소여야 한다 (Circom_CalcWit::setComponentPosition)
+  u32 nameDimsSize = 0;
+  u32 nameIndex = 0;
   u32* subcomponents = NULL;
   bool* subcomponentsParallel = NULL;
   bool *outputIsSet = NULL;  //one for each output
   std::mutex *mutexes = NULL;  //one for each output
   std::condition_variable *cvs = NULL;
   std::thread *sbct = NULL;//subcomponent threads
+  u32 parallelDone = 0;  // 풀에서 실행한 병렬 컴포넌트가 끝나면 1 (__atomic 으로 접근)
 };
 
+static_assert(std::is_trivially_copyable<Circom_Component>::value, "Circom_Component must stay POD-like");
+
 /*
 For every template instantiation create two functions:
 - name_create
@@ -85,5 +105,8 @@ uint get_size_of_witness();
 uint get_size_of_constants();
 uint get_size_of_io_map();
 uint get_size_of_bus_field_map();
+// 아래 둘은 stock circom 출력에 없다. circom_postprocess.py (names) 가 생성한다
+uint get_number_of_templates();
+const char *get_template_name(uint templateId);
 
 #endif  // __CIRCOM_H
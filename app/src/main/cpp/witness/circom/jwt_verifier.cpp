@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <iostream>
+#include <assert.h>
+#include "circom.hpp"
+#include "calcwit.hpp"
+void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void IsZero_0_run(uint ctx_index,Circom_CalcWit* ctx);
+void RealRSALike_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void RealRSALike_1_run(uint ctx_index,Circom_CalcWit* ctx);
+Circom_TemplateFunction _functionTable[2] = {
+        IsZero_0_run,
+        RealRSALike_1_run };
+Circom_TemplateFunction _functionTableParallel[2] = {
+        NULL,
+        NULL };
+uint get_main_input_signal_start() {return 2;}
+
+uint get_main_input_signal_no() {return 97;}
+
+uint get_total_signal_no() {return 150102;}
+
+uint get_number_of_components() {return 2;}
+
+uint get_size_of_input_hashmap() {return 256;}
+
+uint get_size_of_witness() {return 150036;}
+
+uint get_size_of_constants() {return 6;}
+
+uint get_size_of_io_map() {return 0;}
+
+uint get_size_of_bus_field_map() {return 0;}
+
+void release_memory_component(Circom_CalcWit* ctx, uint pos) {{
+
+        if (pos != 0){{
+
+                if(ctx->componentMemory[pos].subcomponents)
+                    delete []ctx->componentMemory[pos].subcomponents;
+
+                if(ctx->componentMemory[pos].subcomponentsParallel)
+                    delete []ctx->componentMemory[pos].subcomponentsParallel;
+
+                if(ctx->componentMemory[pos].outputIsSet)
+                    delete []ctx->componentMemory[pos].outputIsSet;
+
+                if(ctx->componentMemory[pos].mutexes)
+                    delete []ctx->componentMemory[pos].mutexes;
+
+                if(ctx->componentMemory[pos].cvs)
+                    delete []ctx->componentMemory[pos].cvs;
+
+                if(ctx->componentMemory[pos].sbct)
+                    delete []ctx->componentMemory[pos].sbct;
+
+            }}
+
+
+    }}
+
+
+// function declarations
+// template declarations
+void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+    ctx->componentMemory[coffset].templateId = 0;
+    ctx->componentMemory[coffset].templateName = "IsZero";
+    ctx->componentMemory[coffset].signalStart = soffset;
+    ctx->componentMemory[coffset].inputCounter = 1;
+    ctx->componentMemory[coffset].componentName = componentName;
+    ctx->componentMemory[coffset].idFather = componentFather;
+    ctx->componentMemory[coffset].subcomponents = new uint[0];
+}
+
+void IsZero_0_run(uint ctx_index,Circom_CalcWit* ctx){
+    FrElement* circuitConstants = ctx->circuitConstants;
+    FrElement* signalValues = ctx->signalValues;
+    FrElement expaux[3];
+    FrElement lvar[0];
+    u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
+    std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
+    std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+    u64 myFather = ctx->componentMemory[ctx_index].idFather;
+    u64 myId = ctx_index;
+    u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
+    bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
+    std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
+    uint sub_component_aux;
+    uint index_multiple_eq;
+    int cmp_index_ref_load = -1;
+    Fr_neq(&expaux[0],&signalValues[mySignalStart + 1],&circuitConstants[0]); // line circom 43
+    if(Fr_isTrue(&expaux[0])){
+        {
+            PFrElement aux_dest = &signalValues[mySignalStart + 2];
+// load src
+            Fr_div(&expaux[0],&circuitConstants[1],&signalValues[mySignalStart + 1]); // line circom 43
+// end load src
+            Fr_copy(aux_dest,&expaux[0]);
+        }
+    }else{
+        {
+            PFrElement aux_dest = &signalValues[mySignalStart + 2];
+// load src
+// end load src
+            Fr_copy(aux_dest,&circuitConstants[0]);
+        }
+    }
+    {
+        PFrElement aux_dest = &signalValues[mySignalStart + 0];
+// load src
+        Fr_neg(&expaux[2],&signalValues[mySignalStart + 1]); // line circom 44
+        Fr_mul(&expaux[1],&expaux[2],&signalValues[mySignalStart + 2]); // line circom 44
+        Fr_add(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 44
+// end load src
+        Fr_copy(aux_dest,&expaux[0]);
+    }
+    {
+        Fr_mul(&expaux[1],&signalValues[mySignalStart + 1],&signalValues[mySignalStart + 0]); // line circom 45
+        {{
+                Fr_eq(&expaux[0],&expaux[1],&circuitConstants[0]); // line circom 45
+            }}
+        if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 45. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+        assert(Fr_isTrue(&expaux[0]));
+    }
+    for (uint i = 0; i < 0; i++){
+        uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
+        if (index_subc != 0){
+            assert(!(ctx->componentMemory[index_subc].inputCounter));
+            release_memory_component(ctx,index_subc);
+        }
+    }
+}
+
+void RealRSALike_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+    ctx->componentMemory[coffset].templateId = 1;
+    ctx->componentMemory[coffset].templateName = "RealRSALike";
+    ctx->componentMemory[coffset].signalStart = soffset;
+    ctx->componentMemory[coffset].inputCounter = 97;
+    ctx->componentMemory[coffset].componentName = componentName;
+    ctx->componentMemory[coffset].idFather = componentFather;
+    ctx->componentMemory[coffset].subcomponents = new uint[1]{0};
+}
+
+void RealRSALike_1_run(uint ctx_index,Circom_CalcWit* ctx){
+    FrElement* circuitConstants = ctx->circuitConstants;
+    FrElement* signalValues = ctx->signalValues;
+    FrElement expaux[6];
+    FrElement lvar[3];
+    u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
+    std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
+    std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+    u64 myFather = ctx->componentMemory[ctx_index].idFather;
+    u64 myId = ctx_index;
+    u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
+    bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
+    std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
+    uint sub_component_aux;
+    uint index_multiple_eq;
+    int cmp_index_ref_load = -1;
+    {
+        PFrElement aux_dest = &lvar[0];
+// load src
+// end load src
+        Fr_copy(aux_dest,&circuitConstants[2]);
+    }
+    {
+        PFrElement aux_dest = &lvar[1];
+// load src
+// end load src
+        Fr_copy(aux_dest,&circuitConstants[3]);
+    }
+    {
+        std::string new_cmp_name = "checker";
+        IsZero_0_create(mySignalStart+150098,0+ctx_index+1,ctx,new_cmp_name,myId);
+        mySubcomponents[0] = 0+ctx_index+1;
+    }
+    {
+        PFrElement aux_dest = &signalValues[mySignalStart + 98];
+// load src
+        Fr_mul(&expaux[0],&signalValues[mySignalStart + 1],&signalValues[mySignalStart + 1]); // line circom 21
+// end load src
+        Fr_copy(aux_dest,&expaux[0]);
+    }
+    {
+        PFrElement aux_dest = &lvar[2];
+// load src
+// end load src
+        Fr_copy(aux_dest,&circuitConstants[1]);
+    }
+    Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 24
+    while(Fr_isTrue(&expaux[0])){
+        {
+            PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[2])) + 98)];
+// load src
+            Fr_sub(&expaux[3],&lvar[2],&circuitConstants[1]); // line circom 27
+            Fr_sub(&expaux[4],&lvar[2],&circuitConstants[1]); // line circom 27
+            Fr_mul(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 98)],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[4])) + 98)]); // line circom 27
+            Fr_mod(&expaux[3],&lvar[2],&circuitConstants[2]); // line circom 27
+            Fr_add(&expaux[1],&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 33)]); // line circom 27
+            Fr_mod(&expaux[3],&lvar[2],&circuitConstants[2]); // line circom 27
+            Fr_mul(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 65)],&circuitConstants[0]); // line circom 27
+            Fr_add(&expaux[0],&expaux[1],&expaux[2]); // line circom 27
+// end load src
+            Fr_copy(aux_dest,&expaux[0]);
+        }
+        {
+            PFrElement aux_dest = &lvar[2];
+// load src
+            Fr_add(&expaux[0],&lvar[2],&circuitConstants[1]); // line circom 24
+// end load src
+            Fr_copy(aux_dest,&expaux[0]);
+        }
+        Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 24
+    }
+    {
+        uint cmp_index_ref = 0;
+        {
+            PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
+// load src
+            Fr_sub(&expaux[0],&signalValues[mySignalStart + 150097],&signalValues[mySignalStart + 150097]); // line circom 34
+// end load src
+            Fr_copy(aux_dest,&expaux[0]);
+        }
+// need to run sub component
+        ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
+        assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
+        IsZero_0_run(mySubcomponents[cmp_index_ref],ctx);
+    }
+    {
+        PFrElement aux_dest = &signalValues[mySignalStart + 0];
+// load src
+        cmp_index_ref_load = 0;
+        cmp_index_ref_load = 0;
+        Fr_sub(&expaux[0],&circuitConstants[1],&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 0]); // line circom 36
+// end load src
+        Fr_copy(aux_dest,&expaux[0]);
+    }
+    for (uint i = 0; i < 1; i++){
+        uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
+        if (index_subc != 0){
+            assert(!(ctx->componentMemory[index_subc].inputCounter));
+            release_memory_component(ctx,index_subc);
+        }
+    }
+}
+
+void run(Circom_CalcWit* ctx){
+    RealRSALike_1_create(1,0,ctx,"main",0);
+    RealRSALike_1_run(0,ctx);
+}
+
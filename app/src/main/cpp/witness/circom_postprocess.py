@@ -0,0 +1,423 @@
+#!/usr/bin/env python3
+# circom 이 만든 회로 .cpp 를 이 런타임 (calcwit.hpp / circom.hpp) 에 맞게 바꾼다.
+# 회로를 다시 컴파일하면 circom 출력을 witness/circom/ 에 그대로 두고 이 스크립트로 witness/ 아래 파일을 다시 만든다.
+# 만든 파일은 직접 고치지 않는다 (고칠 것이 있으면 이 스크립트에 변환을 추가한다).
+#
+#   circom_postprocess.py circom/jwt_verifier.cpp jwt_verifier.cpp          # 생성
+#   circom_postprocess.py --check circom/jwt_verifier.cpp jwt_verifier.cpp  # 생성 결과와 같은지 검사 (ctest)
+#
+# 변환:
+#   names    컴포넌트 기술자에서 std::string 제거: 템플릿 이름은 get_template_name(templateId) 표로,
+#            컴포넌트 이름은 문자열 리터럴로, 배열 원소 위치는 setComponentPosition 으로.
+#            subcomponents 등 컴포넌트별 배열은 componentArena 에서 할당한다
+#   signals  신호 배열 직접 접근 -> ctx->loadSignal / ctx->storeSignal (CIRCOM_PACKED_SIGNALS 저장소와 무관하게 동작)
+#   acc      한 식 ("// load src" 블록) 안의 곱 둘 이상의 합을 FrAccumulator 로 묶어 reduction 을 한 번만 한다
+#   profile  "// line circom n" 이 붙은 줄 앞에 CIRCOM_PROF_LINE(n), *_run 입구에 CIRCOM_PROF_TEMPLATE(id) (profiler.hpp)
+#
+# 모르는 형태 (병렬 컴포넌트의 std::thread 등) 가 남으면 오류로 멈춘다.
+import re
+import sys
+
+
+class ConvertError(Exception):
+    pass
+
+
+def matching(text, start, open_ch, close_ch):
+    """text[start] 가 open_ch 일 때 짝이 되는 close_ch 의 위치"""
+    depth = 0
+    for i in range(start, len(text)):
+        if text[i] == open_ch:
+            depth += 1
+        elif text[i] == close_ch:
+            depth -= 1
+            if depth == 0:
+                return i
+    raise ConvertError('unbalanced %s in: %s' % (open_ch, text.strip()))
+
+
+def functions(lines):
+    """최상위 함수 정의의 (시작 줄, 끝 줄) 목록. 본문은 '{' 로 끝나는 시그니처 줄 다음부터 짝이 되는 '}' 까지
+    (circom 은 들여쓰기 없이 내보내기도 하므로 중괄호 깊이로 찾는다)"""
+    out = []
+    i = 0
+    while i < len(lines):
+        if re.match(r'^void \w+\(.*\)\s*\{\s*$', lines[i]):
+            depth = 1
+            j = i
+            while depth > 0:
+                j += 1
+                if j == len(lines):
+                    raise ConvertError('unterminated function: %s' % lines[i].strip())
+                code = re.sub(r'"(\\.|[^"\\])*"', '""', lines[j].split('//')[0])
+                depth += code.count('{') - code.count('}')
+            out.append((i, j))
+            i = j
+        i += 1
+    return out
+
+
+# ---- names ----
+
+ARENA_ARRAYS = ('subcomponents', 'subcomponentsParallel', 'outputIsSet')
+
+
+def pass_names(lines):
+    names = {}
+    template_id = None
+    out = []
+    pending_position = None
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        indent = re.match(r'^(\s*)', line).group(1)
+        line = line.replace('std::string componentName', 'const char *componentName')
+
+        m = re.match(r'^\s*ctx->componentMemory\[coffset\]\.templateId = (\d+);', line)
+        if m:
+            template_id = int(m.group(1))
+        m = re.match(r'^\s*ctx->componentMemory\[coffset\]\.templateName = "(\w+)";\s*$', line)
+        if m:
+            names[template_id] = m.group(1)
+            i += 1
+            continue
+
+        m = re.match(r'^(\s*ctx->componentMemory\[coffset\]\.(\w+) = )new (uint|bool)\[(.+?)\](\{\w*\})?;\s*$', line)
+        if m and m.group(2) in ARENA_ARRAYS:
+            line = '%sctx->componentArena.alloc<%s>(%s);' % (m.group(1), m.group(3), m.group(4))
+
+        # release_memory_component: arena 배열은 reset() 에서 한꺼번에 풀린다
+        m = re.match(r'^\s*if\(ctx->componentMemory\[pos\]\.(\w+)\)\s*$', line)
+        if m and m.group(1) in ARENA_ARRAYS:
+            if m.group(1) == ARENA_ARRAYS[0]:
+                out.append('%s// subcomponents / subcomponentsParallel / outputIsSet 은 componentArena 에서 할당되므로 '
+                           'reset() 에서 한 번에 해제' % indent)
+                i += 2
+            else:
+                i += 3 if i + 2 < len(lines) and not lines[i + 2].strip() else 2
+                if out and not out[-1].strip():
+                    out.pop()
+                out.append('')
+            continue
+
+        line = line.replace('std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;',
+                            'const char *myTemplateName = get_template_name(ctx->componentMemory[ctx_index].templateId);')
+        line = line.replace('std::string myComponentName = ', 'const char *myComponentName = ')
+        line = line.replace('std::string new_cmp_name = "', 'const char *new_cmp_name = "')
+
+        # 배열 원소: 이름 + generate_position_array(...) 대신 위치만 기록한다 (dims 는 정적 저장소여야 한다)
+        m = re.match(r'^(\s*)const char \*new_cmp_name = "(\w+)"\s*\+\s*ctx->generate_position_array\((.+)\);\s*$', line)
+        if m:
+            line = '%sconst char *new_cmp_name = "%s";' % (m.group(1), m.group(2))
+            pending_position = m.group(3)
+        m = re.match(r'^(\s*)uint (aux_dimensions\w*\[.*\] = \{.*\};)\s*$', line)
+        if m:
+            line = '%sstatic const uint %s' % (m.group(1), m.group(2))
+        m = re.match(r'^(\s*)\w+_create\((.+?),(.+?),ctx,new_cmp_name,\w+\);\s*$', line)
+        if m and pending_position:
+            out.append(line)
+            line = '%sctx->setComponentPosition(%s,%s);' % (m.group(1), m.group(3), pending_position)
+            pending_position = None
+
+        if 'std::string' in line and 'listOfTemplateMessages' not in line:
+            raise ConvertError('unsupported std::string in component code: %s' % line.strip())
+        out.append(line)
+        i += 1
+
+    # 템플릿 이름 표는 get_size_of_bus_field_map() 뒤에 둔다
+    if sorted(names) != list(range(len(names))):
+        raise ConvertError('template ids are not contiguous: %s' % sorted(names))
+    table = ['// templateId 순서의 템플릿 이름 (assert 메시지용)',
+             'static const char *templateNames[] = {%s};' % ', '.join('"%s"' % names[k] for k in sorted(names)),
+             '',
+             'uint get_number_of_templates() {return %d;}' % len(names),
+             '',
+             'const char *get_template_name(uint templateId) {return templateNames[templateId];}',
+             '']
+    for k, line in enumerate(out):
+        if line.startswith('uint get_size_of_bus_field_map()'):
+            return out[:k + 2] + table + out[k + 2:]
+    raise ConvertError('get_size_of_bus_field_map() not found')
+
+
+# ---- signals ----
+
+SIGNAL_REF = re.compile(r'&(?:ctx->)?signalValues\[')
+SIGNAL_DEST = re.compile(r'^(\s*)PFrElement aux_dest = &(?:ctx->)?signalValues\[')
+
+
+def replace_loads(line, counter):
+    """&signalValues[e] 읽기를 ctx->loadSignal(e,&sigaux[k]) 로. k 는 줄마다 0 부터"""
+    out = ''
+    pos = 0
+    while True:
+        m = SIGNAL_REF.search(line, pos)
+        if not m:
+            return out + line[pos:], counter
+        end = matching(line, m.end() - 1, '[', ']')
+        expr = line[m.end():end]
+        out += line[pos:m.start()] + 'ctx->loadSignal(%s,&sigaux[%d])' % (expr, counter)
+        counter += 1
+        pos = end + 1
+
+
+def pass_signals(lines):
+    for start, end in functions(lines):
+        uses_signals = False
+        max_aux = 0
+        signal_dest = False
+        decl = None
+        for i in range(start + 1, end):
+            line = lines[i]
+            if re.match(r'^\s*FrElement\* signalValues = ctx->signalValues;\s*$', line):
+                decl = i
+                continue
+            m = SIGNAL_DEST.match(line)
+            if m:
+                close = matching(line, m.end() - 1, '[', ']')
+                lines[i] = '%su64 aux_dest = %s;' % (m.group(1), line[m.end():close])
+                signal_dest = True
+                continue
+            if re.match(r'^\s*PFrElement aux_dest = ', line):
+                signal_dest = False
+            if signal_dest:
+                m = re.match(r'^(\s*)Fr_copy\(aux_dest,(.*)\);\s*$', line)
+                if m:
+                    src, n = replace_loads(m.group(2), 0)
+                    lines[i] = '%sctx->storeSignal(aux_dest,%s);' % (m.group(1), src)
+                    max_aux = max(max_aux, n)
+                    uses_signals = True
+                    continue
+                m = re.match(r'^(\s*)Fr_copyn\(aux_dest,(.*),(.+)\);\s*$', line)
+                if m:
+                    src = m.group(2)
+                    sm = SIGNAL_REF.match(src)
+                    if sm:
+                        src = 'ctx->loadSignal(%s + i_copy,&sigaux[0])' % src[sm.end():matching(src, sm.end() - 1, '[', ']')]
+                        max_aux = max(max_aux, 1)
+                    else:
+                        src = '%s + i_copy' % src
+                    lines[i] = '%sfor (uint i_copy = 0; i_copy < %s; i_copy++) ctx->storeSignal(aux_dest + i_copy,%s);' % (
+                        m.group(1), m.group(3), src)
+                    uses_signals = True
+                    continue
+                if 'aux_dest' in line and not line.strip().startswith('//'):
+                    raise ConvertError('unsupported use of a signal aux_dest: %s' % line.strip())
+            new, n = replace_loads(line, 0)
+            if n:
+                lines[i] = new
+                max_aux = max(max_aux, n)
+                uses_signals = True
+        if decl is not None:
+            indent = re.match(r'^(\s*)', lines[decl]).group(1)
+            lines[decl] = '%sFrElement sigaux[%d];' % (indent, max(max_aux, 1))
+        elif uses_signals:
+            raise ConvertError('signal access without a signalValues declaration in: %s' % lines[start].strip())
+    return lines
+
+
+# ---- acc ----
+
+FR_OP = re.compile(r'^(\s*)Fr_(add|sub|mul)\((.*)\);(\s*//.*)?$')
+TEMP = re.compile(r'^&expaux\[\d+\]$')
+
+
+def split_args(args):
+    out = []
+    depth = 0
+    cur = ''
+    for ch in args:
+        if ch in '([':
+            depth += 1
+        elif ch in ')]':
+            depth -= 1
+        if ch == ',' and depth == 0:
+            out.append(cur.strip())
+            cur = ''
+        else:
+            cur += ch
+    out.append(cur.strip())
+    return out
+
+
+def fuse_block(lines, first, last):
+    """lines[first:last] 의 식을 누산기로 바꾼 줄 (줄 번호 -> 새 줄 목록). 바꿀 수 없으면 None.
+    마지막 문장 (Fr_add / Fr_sub) 에서 거꾸로, 한 번만 읽히는 expaux 임시값을 만든 Fr_add / Fr_sub / Fr_mul 을
+    따라가며 항으로 펼친다. 곱의 인자는 펼치지 않는다 (그대로 누산기에 곱해 더한다)"""
+    stmts = []
+    for i in range(first, last):
+        m = FR_OP.match(lines[i])
+        if m:
+            args = split_args(m.group(3))
+            if len(args) == 3:
+                stmts.append((i, m.group(1), m.group(2), args, m.group(4) or ''))
+                continue
+        if lines[i].strip() and not lines[i].strip().startswith('//'):
+            stmts.append((i, None, None, None, None))
+    if not stmts or stmts[-1][2] not in ('add', 'sub'):
+        return None
+
+    def mentions(k, temp):
+        return temp in lines[stmts[k][0]]
+
+    def single_use_def(k, temp):
+        """stmts[k] 가 읽는 temp 를 만든 문장의 위치. temp 가 그 사이에 다른 곳에서 읽히면 None"""
+        if not TEMP.match(temp):
+            return None
+        for d in range(k - 1, -1, -1):
+            if stmts[d][3] is not None and stmts[d][3][0] == temp:
+                if stmts[d][2] not in ('add', 'sub', 'mul') or temp in stmts[d][3][1:]:
+                    return None
+                if any(mentions(x, temp) for x in range(d + 1, k)):
+                    return None
+                for x in range(k + 1, len(stmts)):
+                    if stmts[x][3] is not None and stmts[x][3][0] == temp:
+                        break
+                    if mentions(x, temp):
+                        return None
+                if lines[stmts[k][0]].count(temp) != 1:
+                    return None
+                return d
+            if mentions(d, temp):
+                return None
+        return None
+
+    fused = {}     # stmts 위치 -> [(kind, 피연산자)]
+    todo = [len(stmts) - 1]
+    while todo:
+        k = todo.pop()
+        op, (dest, a, b) = stmts[k][2], stmts[k][3]
+        if op == 'mul':
+            fused[k] = [('mul', (a, b))]
+            continue
+        terms = []
+        for n, x in enumerate((a, b)):
+            d = single_use_def(k, x)
+            if d is not None and not (op == 'sub' and n == 1):
+                todo.append(d)
+            else:
+                terms.append(('sub' if op == 'sub' and n == 1 else 'add', (x,)))
+        fused[k] = terms
+    # 곱이 하나뿐이면 Fr_mul 의 reduction 한 번과 다를 것이 없다
+    if sum(1 for k in fused if stmts[k][2] == 'mul') < 2:
+        return None
+
+    root = stmts[-1][3][0]
+    out = {}
+    order = sorted(fused)
+    for k in order:
+        i, indent, comment = stmts[k][0], stmts[k][1], stmts[k][4]
+        new = []
+        if k == order[0]:
+            new += ['%s// a*b + c + d*k 를 누산기로 합쳐 reduction 을 한 번만 한다' % indent,
+                    '%sFr_accInit(&expacc);' % indent]
+        for kind, xs in fused[k]:
+            if kind == 'mul':
+                new.append('%sFr_accMulAdd(&expacc,%s,%s);%s' % (indent, xs[0], xs[1], comment))
+            elif kind == 'add':
+                new.append('%sFr_accAdd(&expacc,%s);%s' % (indent, xs[0], comment))
+            else:
+                new.append('%sFr_accSub(&expacc,%s);%s' % (indent, xs[0], comment))
+        if k == order[-1]:
+            new.append('%sFr_accFinish(%s,&expacc);%s' % (indent, root, comment))
+        out[i] = new
+    return out
+
+
+def pass_acc(lines):
+    result = []
+    for start, end in functions(lines):
+        fused = {}
+        i = start + 1
+        while i < end:
+            if lines[i].strip() == '// load src':
+                j = i + 1
+                while lines[j].strip() != '// end load src':
+                    j += 1
+                fused.update(fuse_block(lines, i + 1, j) or {})
+                i = j
+            i += 1
+        if fused:
+            result.append((start, end, fused))
+    for start, end, fused in reversed(result):
+        for i in sorted(fused, reverse=True):
+            lines[i:i + 1] = fused[i]
+        for i in range(start + 1, end):
+            m = re.match(r'^(\s*)FrElement lvar\[\d+\];\s*$', lines[i])
+            if m:
+                lines.insert(i + 1, '%sFrAccumulator expacc;' % m.group(1))
+                break
+        else:
+            raise ConvertError('no lvar declaration in: %s' % lines[start].strip())
+    return lines
+
+
+# ---- profile ----
+
+def pass_profile(lines):
+    template_ids = {}
+    for start, end in functions(lines):
+        m = re.match(r'^void (\w+)_create\(', lines[start])
+        if m:
+            for i in range(start + 1, end):
+                t = re.match(r'^\s*ctx->componentMemory\[coffset\]\.templateId = (\d+);', lines[i])
+                if t:
+                    template_ids[m.group(1)] = int(t.group(1))
+    # 뒤에서부터 끼워 넣어 앞쪽 함수의 줄 번호가 바뀌지 않게 한다
+    for start, end in reversed(functions(lines)):
+        for i in range(start + 1, end):
+            m = re.match(r'^(\s*)(.*// line circom (\d+))$', lines[i])
+            if m:
+                lines[i] = '%sCIRCOM_PROF_LINE(%s); %s' % (m.group(1), m.group(3), m.group(2))
+        m = re.match(r'^void (\w+)_run\(', lines[start])
+        if m:
+            if m.group(1) not in template_ids:
+                raise ConvertError('no templateId for %s_run' % m.group(1))
+            indent = re.match(r'^(\s*)', lines[start + 1]).group(1)
+            lines.insert(start + 1, '%sCIRCOM_PROF_TEMPLATE(%d);' % (indent, template_ids[m.group(1)]))
+    for k, line in enumerate(lines):
+        if line == '#include "calcwit.hpp"':
+            lines.insert(k + 1, '#include "profiler.hpp"')
+            return lines
+    raise ConvertError('#include "calcwit.hpp" not found')
+
+
+PASSES = [pass_names, pass_signals, pass_acc, pass_profile]
+
+
+def convert(text):
+    lines = text.split('\n')
+    for p in PASSES:
+        lines = p(lines)
+    out = '\n'.join(lines)
+    for bad in ('signalValues', 'std::thread'):
+        if bad in out:
+            raise ConvertError('unsupported circom construct left in output: %s' % bad)
+    return out
+
+
+def main(argv):
+    check = argv[1:2] == ['--check']
+    args = argv[2:] if check else argv[1:]
+    if len(args) != 2:
+        sys.stderr.write('usage: %s [--check] <circom output .cpp> <runtime .cpp>\n' % argv[0])
+        return 2
+    try:
+        with open(args[0]) as f:
+            out = convert(f.read())
+    except ConvertError as e:
+        sys.stderr.write('%s: %s\n' % (args[0], e))
+        return 1
+    if check:
+        with open(args[1]) as f:
+            if f.read() != out:
+                sys.stderr.write('%s is not the converted %s (run %s %s %s)\n' % (args[1], args[0], argv[0], args[0], args[1]))
+                return 1
+        return 0
+    with open(args[1], 'w') as f:
+        f.write(out)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
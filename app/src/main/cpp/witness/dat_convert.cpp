@@ -0,0 +1,47 @@
+// raw circuit.dat (또는 version 1 컨테이너) 를 version 2 컨테이너 (datfile.hpp) 로 바꾸는 도구 (WITNESS_BUILD_DAT_CONVERT=ON 일 때만 빌드)
+// 회로 .cpp 와 같이 링크되어 그 회로의 크기 정보로 구간을 나누고 회로 해시를 넣는다.
+// witness 목록은 run 구간으로 줄인다 (src/main/assets/circuit.dat 은 이 도구의 출력이다).
+// 사용법: dat-convert <raw circuit.dat> <출력 .dat>
+//   adb push dat-convert circuit.dat /data/local/tmp && adb shell /data/local/tmp/dat-convert ...
+// 이미 컨테이너인 파일은 열어서 모든 구간의 checksum 을 검사만 한다.
+#include <stdio.h>
+#include <string>
+#include "datfile.hpp"
+#include "mappedfile.hpp"
+
+static int verifyContainer(const char *path) {
+    Circom_MappedFile file;
+    if (!file.open(path)) {
+        fprintf(stderr, "cannot map %s\n", path);
+        return 1;
+    }
+    Circom_DatContainer dat;
+    std::string error;
+    if (!dat.open(file.data(), file.size(), error)) {
+        fprintf(stderr, "%s: %s\n", path, error.c_str());
+        return 1;
+    }
+    for (int type = 1; type <= Circom_DAT_SECTION_COUNT; type++) {
+        size_t len;
+        if (!dat.locate(type, len)) continue;
+        bool ok = dat.verify(type);
+        printf("section %d: %zu bytes, checksum %s\n", type, len, ok ? "ok" : "MISMATCH");
+        if (!ok) return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 2) return verifyContainer(argv[1]);
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <raw.dat | v1.dat> <out.dat>\n       %s <container.dat>   (verify)\n", argv[0], argv[0]);
+        return 2;
+    }
+    std::string error;
+    if (!Circom_convertDat(argv[1], argv[2], error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    printf("wrote %s (circuit hash %016llx)\n", argv[2], (unsigned long long)Circom_circuitHash());
+    return verifyContainer(argv[2]);
+}
@@ -0,0 +1,313 @@
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "datfile.hpp"
+#include "mappedfile.hpp"
+#include "circom.hpp"
+
+#define FNV_PRIME 0x100000001B3ULL
+
+uint64_t Circom_datChecksum(const void *data, size_t len, uint64_t seed) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint64_t h = seed;
+    size_t words = len / 8;
+    for (size_t i = 0; i < words; i++) {
+        uint64_t w;
+        memcpy(&w, p + i * 8, 8);
+        h = (h ^ w) * FNV_PRIME;
+    }
+    if (len % 8) {
+        uint64_t w = 0;
+        memcpy(&w, p + words * 8, len % 8);
+        h = (h ^ w) * FNV_PRIME;
+    }
+    return h;
+}
+
+uint64_t Circom_circuitHash() {
+    uint64_t info[] = {
+            get_main_input_signal_start(), get_main_input_signal_no(), get_total_signal_no(),
+            get_number_of_components(), get_size_of_input_hashmap(), get_size_of_witness(),
+            get_size_of_constants(), get_size_of_io_map(), get_size_of_bus_field_map(),
+            get_number_of_templates(), sizeof(HashSignalInfo), sizeof(FrElement)
+    };
+    uint64_t h = Circom_datChecksum(info, sizeof(info));
+    // 템플릿 이름은 templateId 순서로, 각 이름 뒤에 길이를 붙여 경계가 섞이지 않게 한다
+    for (uint i = 0; i < get_number_of_templates(); i++) {
+        const char *name = get_template_name(i);
+        uint64_t len = strlen(name);
+        h = Circom_datChecksum(name, len, h);
+        h = Circom_datChecksum(&len, sizeof(len), h);
+    }
+    return h;
+}
+
+// 회로가 기대하는 구간 길이 (IO map 은 회로 정보로 길이를 알 수 없어 제외)
+static size_t expectedLength(int type) {
+    switch (type) {
+        case Circom_DAT_INPUT_HASHMAP: return (size_t)get_size_of_input_hashmap() * sizeof(HashSignalInfo);
+        case Circom_DAT_WITNESS_MAP: return (size_t)get_size_of_witness() * sizeof(u64);
+        case Circom_DAT_CONSTANTS: return (size_t)get_size_of_constants() * sizeof(FrElement);
+        // WITNESS_RUNS 는 길이가 정해져 있지 않다 (Circom_checkWitnessRuns 로 검사)
+        default: return 0;
+    }
+}
+
+Circom_DatContainer::Circom_DatContainer() {
+    close();
+}
+
+void Circom_DatContainer::close() {
+    container = false;
+    for (int i = 0; i < Circom_DAT_SECTION_COUNT; i++) {
+        entries[i].data = NULL;
+        entries[i].length = 0;
+        entries[i].checksum = 0;
+        entries[i].state = 0;
+    }
+}
+
+bool Circom_DatContainer::openRaw(const uint8_t *data, size_t size, std::string &error) {
+    size_t offset = 0;
+    for (int type = Circom_DAT_INPUT_HASHMAP; type <= Circom_DAT_CONSTANTS; type++) {
+        size_t len = expectedLength(type);
+        if (len > size - offset) {
+            error = "raw .dat is too small: need " + std::to_string(offset + len) + " bytes, file " + std::to_string(size);
+            return false;
+        }
+        Entry &e = entries[type - 1];
+        e.data = data + offset;
+        e.length = len;
+        e.state = 1;  // raw 는 checksum 이 없다
+        offset += len;
+    }
+    Entry &io = entries[Circom_DAT_IO_MAP - 1];
+    io.data = data + offset;
+    io.length = size - offset;
+    io.state = 1;
+    container = false;
+    return true;
+}
+
+bool Circom_DatContainer::open(const uint8_t *data, size_t size, std::string &error) {
+    if (size < sizeof(Circom_DatHeader) || memcmp(data, CIRCOM_DAT_MAGIC, 8) != 0) {
+        return openRaw(data, size, error);
+    }
+
+    Circom_DatHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.version < 1 || header.version > CIRCOM_DAT_VERSION) {
+        error = "unsupported .dat version " + std::to_string(header.version);
+        return false;
+    }
+    if (header.alignment < 8 || (header.alignment & (header.alignment - 1)) != 0) {
+        error = "bad .dat alignment " + std::to_string(header.alignment);
+        return false;
+    }
+    if (header.circuitHash != Circom_circuitHash()) {
+        error = ".dat was built for a different circuit";
+        return false;
+    }
+    if (header.sectionCount > 64 ||
+        header.sectionCount * sizeof(Circom_DatSection) > size - sizeof(Circom_DatHeader)) {
+        error = "truncated .dat section table";
+        return false;
+    }
+
+    const uint8_t *table = data + sizeof(Circom_DatHeader);
+    size_t tableSize = header.sectionCount * sizeof(Circom_DatSection);
+    uint64_t tableChecksum = header.tableChecksum;
+    header.tableChecksum = 0;
+    if (Circom_datChecksum(table, tableSize, Circom_datChecksum(&header, sizeof(header))) != tableChecksum) {
+        error = ".dat header checksum mismatch";
+        return false;
+    }
+
+    size_t dataStart = sizeof(Circom_DatHeader) + tableSize;
+    for (uint32_t i = 0; i < header.sectionCount; i++) {
+        Circom_DatSection s;
+        memcpy(&s, table + i * sizeof(Circom_DatSection), sizeof(s));
+        if (s.type < 1 || s.type > Circom_DAT_SECTION_COUNT) continue;  // 모르는 구간은 건너뛴다 (이후 버전)
+        Entry &e = entries[s.type - 1];
+        if (e.data) {
+            error = "duplicate .dat section " + std::to_string(s.type);
+            return false;
+        }
+        if (s.offset < dataStart || s.offset % header.alignment != 0 || s.offset > size || s.length > size - s.offset) {
+            error = "bad .dat section " + std::to_string(s.type) + " bounds";
+            return false;
+        }
+        e.data = data + s.offset;
+        e.length = (size_t)s.length;
+        e.checksum = s.checksum;
+        e.state = 0;
+    }
+
+    // 필수 구간: 입력 표, 상수, witness 목록 또는 run 중 하나
+    const Entry &runs = entries[Circom_DAT_WITNESS_RUNS - 1];
+    if (runs.data && runs.length % sizeof(Circom_WitnessRun) != 0) {
+        error = "bad .dat witness runs length";
+        return false;
+    }
+    for (int type = Circom_DAT_INPUT_HASHMAP; type <= Circom_DAT_SECTION_COUNT; type++) {
+        const Entry &e = entries[type - 1];
+        bool required = type == Circom_DAT_INPUT_HASHMAP || type == Circom_DAT_CONSTANTS ||
+                        (type == Circom_DAT_WITNESS_MAP && !runs.data);
+        if (required && (!e.data || e.length != expectedLength(type))) {
+            error = "missing or wrong-sized .dat section " + std::to_string(type);
+            return false;
+        }
+        // 구간끼리 겹치지 않아야 한다
+        for (int other = type + 1; other <= Circom_DAT_SECTION_COUNT; other++) {
+            const Entry &o = entries[other - 1];
+            if (!e.data || !o.data || o.length == 0 || e.length == 0) continue;
+            if (e.data < o.data + o.length && o.data < e.data + e.length) {
+                error = "overlapping .dat sections";
+                return false;
+            }
+        }
+    }
+    container = true;
+    return true;
+}
+
+const uint8_t *Circom_DatContainer::locate(int type, size_t &length) const {
+    length = 0;
+    if (type < 1 || type > Circom_DAT_SECTION_COUNT) return NULL;
+    const Entry &e = entries[type - 1];
+    length = e.length;
+    return e.data;
+}
+
+bool Circom_DatContainer::verify(int type) {
+    if (type < 1 || type > Circom_DAT_SECTION_COUNT) return false;
+    Entry &e = entries[type - 1];
+    if (!e.data) return false;
+    int state = e.state.load(std::memory_order_acquire);
+    if (state == 0) {
+        state = Circom_datChecksum(e.data, e.length) == e.checksum ? 1 : -1;
+        e.state.store(state, std::memory_order_release);
+    }
+    return state > 0;
+}
+
+void Circom_encodeWitnessRuns(const uint64_t *list, size_t n, std::vector<Circom_WitnessRun> &runs) {
+    runs.clear();
+    for (size_t i = 0; i < n; i++) {
+        if (!runs.empty() && runs.back().signal + runs.back().count == list[i]) {
+            runs.back().count++;
+        } else {
+            Circom_WitnessRun run = {list[i], 1};
+            runs.push_back(run);
+        }
+    }
+}
+
+bool Circom_checkWitnessRuns(const Circom_WitnessRun *runs, size_t nRuns, std::string &error) {
+    uint64_t total = 0;
+    uint64_t nSignals = get_total_signal_no();
+    for (size_t i = 0; i < nRuns; i++) {
+        if (runs[i].count == 0 || runs[i].signal > nSignals || runs[i].count > nSignals - runs[i].signal) {
+            error = "witness run " + std::to_string(i) + " is out of the signal range";
+            return false;
+        }
+        total += runs[i].count;
+    }
+    if (total != get_size_of_witness()) {
+        error = "witness runs cover " + std::to_string(total) + " witnesses, circuit has " +
+                std::to_string(get_size_of_witness());
+        return false;
+    }
+    return true;
+}
+
+bool Circom_convertDat(const char *rawPath, const char *outPath, std::string &error) {
+    Circom_MappedFile raw;
+    if (!raw.open(rawPath)) {
+        error = std::string("cannot map ") + rawPath;
+        return false;
+    }
+    Circom_DatContainer in;
+    if (!in.open(raw.data(), raw.size(), error)) return false;
+
+    // 모든 구간의 checksum 을 검사하며 꺼낸다 (raw 는 검사 없음)
+    const uint8_t *payload[Circom_DAT_SECTION_COUNT];
+    size_t length[Circom_DAT_SECTION_COUNT];
+    for (int i = 0; i < Circom_DAT_SECTION_COUNT; i++) {
+        size_t len;
+        payload[i] = in.locate(i + 1, len);
+        length[i] = payload[i] ? len : 0;
+        if (payload[i] && !in.verify(i + 1)) {
+            error = std::string(rawPath) + ": section " + std::to_string(i + 1) + " checksum mismatch";
+            return false;
+        }
+    }
+    const int mapIdx = Circom_DAT_WITNESS_MAP - 1, runsIdx = Circom_DAT_WITNESS_RUNS - 1;
+    if (payload[runsIdx]) {
+        error = std::string(rawPath) + " already has witness runs";
+        return false;
+    }
+
+    std::vector<Circom_WitnessRun> runs;
+    Circom_encodeWitnessRuns((const uint64_t *)payload[mapIdx], length[mapIdx] / sizeof(uint64_t), runs);
+    if (runs.size() * sizeof(Circom_WitnessRun) <= length[mapIdx] / 2) {
+        payload[runsIdx] = (const uint8_t *)runs.data();
+        length[runsIdx] = runs.size() * sizeof(Circom_WitnessRun);
+        payload[mapIdx] = NULL;
+        length[mapIdx] = 0;
+    }
+
+    Circom_DatHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CIRCOM_DAT_MAGIC, 8);
+    header.version = CIRCOM_DAT_VERSION;
+    header.alignment = CIRCOM_DAT_ALIGNMENT;
+    header.circuitHash = Circom_circuitHash();
+
+    // 있는 구간만 표에 넣는다 (빈 IO map 은 길이 0 으로 남긴다)
+    std::vector<Circom_DatSection> table;
+    std::vector<const uint8_t *> data;
+    for (int i = 0; i < Circom_DAT_SECTION_COUNT; i++) {
+        if (!payload[i] && i != Circom_DAT_IO_MAP - 1) continue;
+        Circom_DatSection s;
+        s.type = i + 1;
+        s.reserved = 0;
+        s.length = length[i];
+        s.checksum = Circom_datChecksum(payload[i], length[i]);
+        table.push_back(s);
+        data.push_back(payload[i]);
+    }
+    header.sectionCount = (uint32_t)table.size();
+    uint64_t offset = sizeof(header) + table.size() * sizeof(Circom_DatSection);
+    for (size_t i = 0; i < table.size(); i++) {
+        offset = (offset + CIRCOM_DAT_ALIGNMENT - 1) & ~(uint64_t)(CIRCOM_DAT_ALIGNMENT - 1);
+        table[i].offset = offset;
+        offset += table[i].length;
+    }
+    header.tableChecksum = Circom_datChecksum(table.data(), table.size() * sizeof(Circom_DatSection),
+                                              Circom_datChecksum(&header, sizeof(header)));
+
+    // 임시 파일에 다 쓴 뒤 rename 해서, 중간에 실패해도 반쯤 쓴 파일이 남지 않게 한다
+    std::string tmpPath = std::string(outPath) + ".tmp";
+    FILE *out = fopen(tmpPath.c_str(), "wb");
+    if (!out) {
+        error = "cannot create " + tmpPath;
+        return false;
+    }
+    static const uint8_t zeros[CIRCOM_DAT_ALIGNMENT] = {0};
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+              fwrite(table.data(), sizeof(Circom_DatSection), table.size(), out) == table.size();
+    uint64_t pos = sizeof(header) + table.size() * sizeof(Circom_DatSection);
+    for (size_t i = 0; ok && i < table.size(); i++) {
+        ok = fwrite(zeros, 1, table[i].offset - pos, out) == table[i].offset - pos;
+        if (ok && table[i].length) ok = fwrite(data[i], table[i].length, 1, out) == 1;
+        pos = table[i].offset + table[i].length;
+    }
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || rename(tmpPath.c_str(), outPath) != 0) {
+        remove(tmpPath.c_str());
+        error = std::string("cannot write ") + outPath;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,117 @@
+#ifndef CIRCOM_DATFILE_HPP
+#define CIRCOM_DATFILE_HPP
+
+// circuit.dat 컨테이너 형식 (version 2, little endian).
+//
+//   Circom_DatHeader | Circom_DatSection[sectionCount] | (padding) | section ... (각각 alignment 경계에서 시작)
+//
+// 헤더에는 회로 해시 (Circom_circuitHash) 가 있어 다른 회로용 .dat 을 거부하고, 구간마다 길이와 checksum 이 있다. 헤더와 구간 표는 열 때 바로 검사하고,
+// 구간 checksum 은 구간별로 verify() 가 따로 계산한다 (파일 전체를 한 번에 훑지 않는다).
+// 로더 (native-witness.cpp) 는 읽는 구간 (입력 표, witness 표, 상수) 을 모두 로드 중에 검사하고, 읽지 않는 IO map 은 검사하지 않는다.
+// 복사 로드는 로드 직후 매핑을 닫으므로 검사를 첫 사용까지 미룰 수 없다.
+// witness 목록은 witness 번호 -> 신호 번호 표인데 거의 전부 1씩 늘어나는 구간이라, version 2 는 이를
+// Circom_WitnessRun 의 배열 (WITNESS_RUNS) 로 저장한다 (이 회로는 150036 개 u64 = 1.2MB 가 3 개 run = 48바이트).
+// version 1 은 u64 배열 (WITNESS_MAP) 이고, 둘 중 하나만 있으면 된다.
+// 헤더가 없는 기존 raw .dat (InputHashMap | witness2SignalList | circuitConstants | IO map) 도 그대로 열리며,
+// 이때는 크기 정보로 구간을 나누고 checksum 검사는 없다. Circom_convertDat 으로 컨테이너로 바꿀 수 있다.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#define CIRCOM_DAT_MAGIC "CIRCMDAT"
+#define CIRCOM_DAT_VERSION 2
+#define CIRCOM_DAT_ALIGNMENT 64
+
+enum {
+    Circom_DAT_INPUT_HASHMAP = 1,
+    Circom_DAT_WITNESS_MAP = 2,
+    Circom_DAT_CONSTANTS = 3,
+    Circom_DAT_IO_MAP = 4,
+    Circom_DAT_WITNESS_RUNS = 5,
+    Circom_DAT_SECTION_COUNT = 5
+};
+
+struct Circom_DatHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t alignment;
+    uint64_t circuitHash;
+    uint32_t sectionCount;
+    uint32_t reserved;
+    uint64_t tableChecksum;  // 이 필드를 0 으로 둔 헤더 + 구간 표의 checksum
+};
+
+struct Circom_DatSection {
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t length;
+    uint64_t checksum;
+};
+
+// witness 번호가 이어지는 동안 신호 번호도 1씩 늘어나는 구간. witness 번호는 앞 run 들의 count 합이다
+struct Circom_WitnessRun {
+    uint64_t signal;
+    uint64_t count;
+};
+
+static_assert(sizeof(Circom_DatHeader) == 40, "container header layout");
+static_assert(sizeof(Circom_DatSection) == 32, "container section layout");
+
+// 8바이트 단위 FNV-1a (끝의 자투리는 0 으로 채운 한 단어). 구간 길이는 보통 8의 배수다
+uint64_t Circom_datChecksum(const void *data, size_t len, uint64_t seed = 0xCBF29CE484222325ULL);
+
+// 컴파일된 회로 .cpp 가 아는 정보의 해시: 크기 정보 (get_size_of_* / 신호 수 / 컴포넌트 수), 구조체 크기,
+// 템플릿 수와 templateId 순서의 템플릿 이름.
+// 잡는 것: 크기가 다른 회로, 템플릿이 추가 / 삭제 / 이름 변경 / 순서 변경된 회로용 .dat.
+// 못 잡는 것: 크기와 템플릿 목록이 같고 상수 값, 입력 이름 (input hash), 템플릿 본문만 바뀐 재컴파일.
+// 이런 값은 .dat 에만 있어 .cpp 쪽에서 비교할 것이 없다. 구간 checksum 은 손상만 잡고 회로 불일치는 잡지 못한다.
+uint64_t Circom_circuitHash();
+
+// 매핑된 .dat 의 구간 표. 구간 포인터는 매핑을 가리키므로 매핑보다 오래 쓰면 안 된다
+class Circom_DatContainer {
+public:
+    Circom_DatContainer();
+
+    // 컨테이너 또는 raw .dat 을 해석한다. 실패하면 false 와 error
+    bool open(const uint8_t *data, size_t size, std::string &error);
+
+    // 구간의 시작과 길이 (범위만 검사된 상태). 없는 구간이면 NULL
+    const uint8_t *locate(int type, size_t &length) const;
+
+    // 구간 checksum 검사. 처음 한 번만 계산하고 결과를 기억한다 (raw .dat 은 항상 true)
+    bool verify(int type);
+
+    // 구간 표를 비운다. 매핑을 닫기 전에 불러 locate 가 닫힌 매핑을 가리키지 않게 한다
+    void close();
+
+    bool isContainer() const { return container; }
+
+private:
+    struct Entry {
+        const uint8_t *data;
+        size_t length;
+        uint64_t checksum;
+        std::atomic<int> state;  // 0 = 아직, 1 = 맞음, -1 = 틀림 (여러 스레드가 같이 계산해도 결과는 같다)
+    };
+
+    Entry entries[Circom_DAT_SECTION_COUNT];
+    bool container;
+
+    bool openRaw(const uint8_t *data, size_t size, std::string &error);
+};
+
+// witness 목록 -> run 배열
+void Circom_encodeWitnessRuns(const uint64_t *list, size_t n, std::vector<Circom_WitnessRun> &runs);
+
+// run 배열이 witness 수와 맞고 신호 범위 (get_total_signal_no) 안에 있는지. 아니면 false 와 error
+bool Circom_checkWitnessRuns(const Circom_WitnessRun *runs, size_t nRuns, std::string &error);
+
+// raw .dat 또는 version 1 컨테이너를 version 2 컨테이너로 바꿔 쓴다. 이 라이브러리에 컴파일된 회로의 크기 정보로 구간을 나눈다
+// witness 목록은 run 으로 바꾸되, 더 커지면 (run 이 목록의 절반을 넘으면) 목록 그대로 둔다
+bool Circom_convertDat(const char *rawPath, const char *outPath, std::string &error);
+
+#endif // CIRCOM_DATFILE_HPP
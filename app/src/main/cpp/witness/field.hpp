@@ -0,0 +1,284 @@
+#ifndef __FIELD_H
+#define __FIELD_H
+
+// 모듈러스를 템플릿 인자로 받는 Montgomery 체 연산.
+// R = 2^(64N) 기준 상수 (R, R^2, R^3 mod q, -q^-1 mod 2^64) 는 컴파일 시간에 계산하고,
+// limb 루프는 N 이 상수이므로 완전히 펼쳐진다. 런타임 초기화나 모듈러스 분기가 없다.
+//
+//   typedef Field<Bn254Fr> F;
+//   F::mul(r, a, b);   // a, b, r 은 [0, q) 의 Montgomery 형식 (aR mod q), limb 는 little-endian
+//
+// 새 체는 N 과 q 만 가진 파라미터 구조체를 추가하면 된다 (q 는 홀수, q < 2^(64N - 1)).
+
+#include <stdint.h>
+
+#if defined(__clang__) || defined(__GNUC__)
+#define FIELD_UNROLL _Pragma("GCC unroll 16")
+#else
+#define FIELD_UNROLL
+#endif
+
+namespace field {
+
+typedef unsigned __int128 u128;
+
+template <int N>
+struct Limbs {
+    uint64_t v[N];
+};
+
+static inline constexpr uint64_t addc(uint64_t a, uint64_t b, uint64_t &carry) {
+    u128 t = (u128)a + b + carry;
+    carry = (uint64_t)(t >> 64);
+    return (uint64_t)t;
+}
+
+static inline constexpr uint64_t subb(uint64_t a, uint64_t b, uint64_t &borrow) {
+    u128 t = (u128)a - b - borrow;
+    borrow = (uint64_t)(t >> 64) & 1;
+    return (uint64_t)t;
+}
+
+// ---- 컴파일 시간 상수 계산 ----
+
+// 2^e mod q: 1 에서 시작해 e 번 두 배 하면서 q 를 뺀다
+template <int N>
+constexpr Limbs<N> pow2Mod(const Limbs<N> &q, int e) {
+    Limbs<N> r = {};
+    r.v[0] = 1;
+    for (int k = 0; k < e; k++) {
+        uint64_t carry = 0;
+        for (int i = 0; i < N; i++) r.v[i] = addc(r.v[i], r.v[i], carry);
+        Limbs<N> t = {};
+        uint64_t borrow = 0;
+        for (int i = 0; i < N; i++) t.v[i] = subb(r.v[i], q.v[i], borrow);
+        if (carry || !borrow) r = t;
+    }
+    return r;
+}
+
+// -q^-1 mod 2^64 (Newton 반복: 비트 수가 매번 두 배)
+constexpr uint64_t negInv64(uint64_t q0) {
+    uint64_t inv = 1;
+    for (int i = 0; i < 6; i++) inv *= 2 - q0 * inv;
+    return 0 - inv;
+}
+
+// (q - 1) / 2
+template <int N>
+constexpr Limbs<N> halfOf(const Limbs<N> &q) {
+    Limbs<N> r = {};
+    for (int i = 0; i < N; i++) {
+        r.v[i] = q.v[i] >> 1;
+        if (i + 1 < N) r.v[i] |= q.v[i + 1] << 63;
+    }
+    return r;
+}
+
+// ---- 모듈러스 파라미터 ----
+
+// BN254 스칼라체 (circom 기본 소수)
+struct Bn254Fr {
+    static constexpr int N = 4;
+    static constexpr Limbs<4> q = {{
+            0x43e1f593f0000001ULL, 0x2833e84879b97091ULL,
+            0xb85045b68181585dULL, 0x30644e72e131a029ULL}};
+};
+
+// BN254 기저체 (Groth16 증명의 G1/G2 좌표)
+struct Bn254Fq {
+    static constexpr int N = 4;
+    static constexpr Limbs<4> q = {{
+            0x3c208c16d87cfd47ULL, 0x97816a916871ca8dULL,
+            0xb85045b68181585dULL, 0x30644e72e131a029ULL}};
+};
+
+// BLS12-381 스칼라체
+struct Bls12381Fr {
+    static constexpr int N = 4;
+    static constexpr Limbs<4> q = {{
+            0xffffffff00000001ULL, 0x53bda402fffe5bfeULL,
+            0x3339d80809a1d805ULL, 0x73eda753299d7d48ULL}};
+};
+
+// ---- 체 연산 ----
+
+template <typename P>
+struct Field {
+    static constexpr int N = P::N;
+    static constexpr Limbs<N> q = P::q;
+    static constexpr Limbs<N> one = pow2Mod<N>(P::q, 64 * N);    // R mod q (Montgomery 형식의 1)
+    static constexpr Limbs<N> R2 = pow2Mod<N>(P::q, 128 * N);
+    static constexpr Limbs<N> R3 = pow2Mod<N>(P::q, 192 * N);
+    static constexpr Limbs<N> halfQ = halfOf<N>(P::q);
+    static constexpr uint64_t np = negInv64(P::q.v[0]);
+
+    static_assert(P::q.v[0] & 1, "modulus must be odd");
+    static_assert(P::q.v[N - 1] >> 63 == 0, "modulus must leave the top bit free");
+
+    static inline void copy(uint64_t *r, const uint64_t *a) {
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) r[i] = a[i];
+    }
+
+    static inline bool isZero(const uint64_t *a) {
+        uint64_t acc = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) acc |= a[i];
+        return acc == 0;
+    }
+
+    static inline bool eq(const uint64_t *a, const uint64_t *b) {
+        uint64_t acc = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) acc |= a[i] ^ b[i];
+        return acc == 0;
+    }
+
+    // carry 가 있거나 r >= q 이면 q 를 한 번 뺀다 (입력은 2q 미만)
+    static inline void reduceOnce(uint64_t *r, uint64_t carry) {
+        uint64_t t[N];
+        uint64_t borrow = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) t[i] = subb(r[i], q.v[i], borrow);
+        if (carry || !borrow) copy(r, t);
+    }
+
+    static inline void add(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        uint64_t carry = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) r[i] = addc(a[i], b[i], carry);
+        reduceOnce(r, carry);
+    }
+
+    static inline void sub(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        uint64_t borrow = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) r[i] = subb(a[i], b[i], borrow);
+        if (borrow) {
+            uint64_t carry = 0;
+            FIELD_UNROLL
+            for (int i = 0; i < N; i++) r[i] = addc(r[i], q.v[i], carry);
+        }
+    }
+
+    static inline void neg(uint64_t *r, const uint64_t *a) {
+        if (isZero(a)) {
+            FIELD_UNROLL
+            for (int i = 0; i < N; i++) r[i] = 0;
+            return;
+        }
+        uint64_t borrow = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) r[i] = subb(q.v[i], a[i], borrow);
+    }
+
+    // 2N limb 값 T (< qR) 를 Montgomery reduction 하여 T * R^-1 mod q 를 구한다. t 는 덮어쓴다.
+    static inline void redc(uint64_t *r, uint64_t *t) {
+        uint64_t top = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) {
+            uint64_t m = t[i] * np;
+            uint64_t c = 0;
+            FIELD_UNROLL
+            for (int j = 0; j < N; j++) {
+                u128 uv = (u128)m * q.v[j] + t[i + j] + c;
+                t[i + j] = (uint64_t)uv;
+                c = (uint64_t)(uv >> 64);
+            }
+            FIELD_UNROLL
+            for (int k = i + N; k < 2 * N; k++) {
+                u128 s = (u128)t[k] + c;
+                t[k] = (uint64_t)s;
+                c = (uint64_t)(s >> 64);
+            }
+            top += c;
+        }
+        copy(r, &t[N]);
+        reduceOnce(r, top);
+    }
+
+    // 2N limb 곱 (reduction 없음)
+    static inline void mulWide(uint64_t *t, const uint64_t *a, const uint64_t *b) {
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) {
+            uint64_t c = 0;
+            FIELD_UNROLL
+            for (int j = 0; j < N; j++) {
+                u128 uv = (u128)a[i] * b[j] + (i ? t[i + j] : 0) + c;
+                t[i + j] = (uint64_t)uv;
+                c = (uint64_t)(uv >> 64);
+            }
+            t[i + N] = c;
+        }
+    }
+
+    static inline void mul(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+        uint64_t t[2 * N];
+        mulWide(t, a, b);
+        redc(r, t);
+    }
+
+    static inline void square(uint64_t *r, const uint64_t *a) {
+        // 교차항 a[i]*a[j] (i<j) 를 한 번만 곱하고 2배 한 뒤 대각항을 더한다
+        uint64_t t[2 * N] = {0};
+        FIELD_UNROLL
+        for (int i = 0; i < N - 1; i++) {
+            uint64_t c = 0;
+            FIELD_UNROLL
+            for (int j = i + 1; j < N; j++) {
+                u128 uv = (u128)a[i] * a[j] + t[i + j] + c;
+                t[i + j] = (uint64_t)uv;
+                c = (uint64_t)(uv >> 64);
+            }
+            t[i + N] = c;
+        }
+        t[2 * N - 1] = t[2 * N - 2] >> 63;
+        FIELD_UNROLL
+        for (int k = 2 * N - 2; k > 0; k--) t[k] = (t[k] << 1) | (t[k - 1] >> 63);
+        t[0] <<= 1;
+        uint64_t c = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) {
+            u128 sq = (u128)a[i] * a[i];
+            t[2 * i] = addc(t[2 * i], (uint64_t)sq, c);
+            t[2 * i + 1] = addc(t[2 * i + 1], (uint64_t)(sq >> 64), c);
+        }
+        redc(r, t);
+    }
+
+    static inline void toMontgomery(uint64_t *r, const uint64_t *a) {
+        mul(r, a, R2.v);
+    }
+
+    static inline void fromMontgomery(uint64_t *r, const uint64_t *a) {
+        uint64_t t[2 * N] = {0};
+        copy(t, a);
+        redc(r, t);
+    }
+
+    // a^e (a 는 Montgomery 형식, e 는 일반 정수 limb). 위 비트부터 제곱-곱셈
+    static inline void pow(uint64_t *r, const uint64_t *a, const uint64_t *e) {
+        uint64_t acc[N], base[N];
+        copy(acc, one.v);
+        copy(base, a);
+        for (int i = 64 * N - 1; i >= 0; i--) {
+            square(acc, acc);
+            if ((e[i >> 6] >> (i & 63)) & 1) mul(acc, acc, base);
+        }
+        copy(r, acc);
+    }
+
+    // 페르마 역원 a^(q-2). 0 의 역원은 0
+    static inline void inv(uint64_t *r, const uint64_t *a) {
+        uint64_t e[N];
+        uint64_t borrow = 0;
+        FIELD_UNROLL
+        for (int i = 0; i < N; i++) e[i] = subb(q.v[i], i == 0 ? 2 : 0, borrow);
+        pow(r, a, e);
+    }
+};
+
+} // namespace field
+
+#endif // __FIELD_H
@@ -1,62 +1,396 @@
 #include "fr.hpp"
+#include "field.hpp"
+#include "profiler.hpp"
 #include <stdio.h>
 #include <stdlib.h>
-#include <gmp.h>
 #include <assert.h>
 #include <string.h>
 #include <iostream>
-#include <android/log.h> // 디버깅용
+#include <atomic>
+
+#include "../native_log.hpp"
 
 #define LOG_TAG "NativeFr"
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#define LOGV(...) NATIVE_LOGV(LOG_TAG, __VA_ARGS__)
+
+// BN128 Modulus 와 Montgomery 상수 (R = 2^256) 는 field.hpp 에서 컴파일 시간에 계산한다
+typedef field::Field<field::Bn254Fr> FrField;
+
+static_assert(FrField::np == 0xc2e1f593efffffffULL, "BN254 -q^-1 mod 2^64");
+static_assert(FrField::R2.v[3] == 0x0216d0b17f4e44a5ULL && FrField::R2.v[0] == 0x1bb8e645ae216da7ULL, "BN254 R^2 mod q");
+static_assert(FrField::one.v[3] == 0x0e0a77c19a07df2fULL && FrField::one.v[0] == 0xac96341c4ffffffbULL, "BN254 R mod q");
 
-// BN128 Modulus
 FrElement Fr_q = {
         0, Fr_LONG,
-        {
-                0x43e1f593f0000001ULL, // [0] 하위 64비트
-                0x2833e84879b97091ULL, // [1]
-                0xb85045b68181585dULL, // [2]
-                0x30644e72e131a029ULL  // [3] 상위 64비트
-        }
+        {FrField::q.v[0], FrField::q.v[1], FrField::q.v[2], FrField::q.v[3]}
+};
+
+// R^2 mod q, R^3 mod q
+FrElement Fr_R2 = {
+        0, Fr_LONG,
+        {FrField::R2.v[0], FrField::R2.v[1], FrField::R2.v[2], FrField::R2.v[3]}
+};
+
+FrElement Fr_R3 = {
+        0, Fr_LONG,
+        {FrField::R3.v[0], FrField::R3.v[1], FrField::R3.v[2], FrField::R3.v[3]}
 };
 
-static mpz_t q;
-static bool initialized = false;
+// Montgomery 형식의 1 (R mod q)
+static const uint64_t *const Fr_rawOne = FrField::one.v;
+
+#define Fr_MONTGOMERY_BIT 0x40000000
+
+// -------------------------------------------------------------------------
+// Raw 4x64 limb 연산 (heap 할당 없음): FrField 인스턴스를 C API 로 노출
+// -------------------------------------------------------------------------
+
+using field::u128;
+using field::addc;
+using field::subb;
+
+// carry가 있거나 r >= q 이면 q를 한 번 뺀다 (입력은 2q 미만)
+static inline void rawReduceOnce(FrRawElement r, uint64_t carry) {
+    FrField::reduceOnce(r, carry);
+}
+
+// 8 limb 값 T (< qR) 를 Montgomery reduction 하여 T * R^-1 mod q 를 구한다
+static inline void rawRedc(FrRawElement r, uint64_t t[8]) {
+    FrField::redc(r, t);
+}
+
+void Fr_rawCopy(FrRawElement pRawResult, const FrRawElement pRawA) {
+    FrField::copy(pRawResult, pRawA);
+}
 
-bool Fr_init() {
-    if (initialized) return false;
-    initialized = true;
-    mpz_init(q);
-    // Packed 제거로 안전하게 접근 가능
-    mpz_import(q, Fr_N64, -1, 8, -1, 0, (const void *)Fr_q.longVal);
-    return true;
+void Fr_rawAdd(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    FrField::add(pRawResult, pRawA, pRawB);
 }
 
-// 안전장치: q가 초기화 안됐으면 강제 초기화
-void check_init() {
-    if (!initialized) Fr_init();
+void Fr_rawSub(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    FrField::sub(pRawResult, pRawA, pRawB);
 }
 
-void Fr_toMpz(mpz_t r, PFrElement pE) {
-    check_init();
-    if (!(pE->type & Fr_LONG)) {
-        mpz_set_si(r, pE->shortVal);
-        if (pE->shortVal < 0) mpz_add(r, r, q);
+void Fr_rawNeg(FrRawElement pRawResult, const FrRawElement pRawA) {
+    FrField::neg(pRawResult, pRawA);
+}
+
+void Fr_rawMMul(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    FrField::mul(pRawResult, pRawA, pRawB);
+}
+
+void Fr_rawMSquare(FrRawElement pRawResult, const FrRawElement pRawA) {
+    FrField::square(pRawResult, pRawA);
+}
+
+void Fr_rawToMontgomery(FrRawElement pRawResult, const FrRawElement pRawA) {
+    FrField::toMontgomery(pRawResult, pRawA);
+}
+
+void Fr_rawFromMontgomery(FrRawElement pRawResult, const FrRawElement pRawA) {
+    FrField::fromMontgomery(pRawResult, pRawA);
+}
+
+// -------------------------------------------------------------------------
+// 역원: Bernstein-Yang safegcd (상수 시간, heap 할당 없음)
+// libsecp256k1 의 modinv64 와 같은 구조로, 값을 부호 있는 62비트 limb 5개로 표현하고
+// 59 divstep 씩 10번(590 divstep, 256비트 입력에 충분) 고정 횟수로 반복한다.
+// -------------------------------------------------------------------------
+
+typedef __int128 i128;
+
+struct FrSigned62 {
+    int64_t v[5];
+};
+
+struct FrTrans2x2 {
+    int64_t u, v, q, r;
+};
+
+static const uint64_t M62 = UINT64_MAX >> 2;
+
+// q 의 signed62 표현과 q^-1 mod 2^62
+static const FrSigned62 Fr_q62 = {{
+        0x03e1f593f0000001LL,
+        0x20cfa121e6e5c245LL,
+        0x05045b68181585d2LL,
+        0x19139cb84c680a6eLL,
+        0x30LL
+}};
+static const uint64_t Fr_qInv62 = 0x3d1e0a6c10000001ULL;
+
+static inline void toSigned62(FrSigned62 &r, const FrRawElement a) {
+    r.v[0] = (int64_t)(a[0] & M62);
+    r.v[1] = (int64_t)(((a[0] >> 62) | (a[1] << 2)) & M62);
+    r.v[2] = (int64_t)(((a[1] >> 60) | (a[2] << 4)) & M62);
+    r.v[3] = (int64_t)(((a[2] >> 58) | (a[3] << 6)) & M62);
+    r.v[4] = (int64_t)(a[3] >> 56);
+}
+
+// a 는 [0, q) 로 정규화된 값이어야 한다
+static inline void fromSigned62(FrRawElement r, const FrSigned62 &a) {
+    const uint64_t v0 = a.v[0], v1 = a.v[1], v2 = a.v[2], v3 = a.v[3], v4 = a.v[4];
+    r[0] = v0 | (v1 << 62);
+    r[1] = (v1 >> 2) | (v2 << 60);
+    r[2] = (v2 >> 4) | (v3 << 58);
+    r[3] = (v3 >> 6) | (v4 << 56);
+}
+
+// 59 divstep 을 수행하고 2^62 배 된 전이 행렬을 t 에 돌려준다.
+// 분기 대신 마스크만 쓰므로 입력 값에 따라 실행 시간이 달라지지 않는다.
+static int64_t divsteps59(int64_t zeta, uint64_t f0, uint64_t g0, FrTrans2x2 &t) {
+    uint64_t u = 8, v = 0, q = 0, r = 8;
+    uint64_t c1, c2, mask1, mask2, f = f0, g = g0, x, y, z;
+    for (int i = 3; i < 62; i++) {
+        c1 = (uint64_t)(zeta >> 63);
+        mask1 = c1;
+        c2 = g & 1;
+        mask2 = 0 - c2;
+        x = (f ^ mask1) - mask1;
+        y = (u ^ mask1) - mask1;
+        z = (v ^ mask1) - mask1;
+        g += x & mask2;
+        q += y & mask2;
+        r += z & mask2;
+        mask1 &= mask2;
+        zeta = (zeta ^ (int64_t)mask1) - 1;
+        f += g & mask1;
+        u += q & mask1;
+        v += r & mask1;
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+    t.u = (int64_t)u;
+    t.v = (int64_t)v;
+    t.q = (int64_t)q;
+    t.r = (int64_t)r;
+    return zeta;
+}
+
+// [d, e] <- t * [d, e] / 2^62 (mod q). d, e 는 (-2q, q) 범위를 유지한다.
+static void updateDE62(FrSigned62 &d, FrSigned62 &e, const FrTrans2x2 &t) {
+    const int64_t d0 = d.v[0], d1 = d.v[1], d2 = d.v[2], d3 = d.v[3], d4 = d.v[4];
+    const int64_t e0 = e.v[0], e1 = e.v[1], e2 = e.v[2], e3 = e.v[3], e4 = e.v[4];
+    const int64_t u = t.u, v = t.v, q = t.q, r = t.r;
+    const int64_t *p = Fr_q62.v;
+    int64_t md, me, sd, se;
+    i128 cd, ce;
+    // d, e 가 음수이면 결과가 음수가 되지 않도록 q 의 배수를 미리 더한다
+    sd = d4 >> 63;
+    se = e4 >> 63;
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+    cd = (i128)u * d0 + (i128)v * e0;
+    ce = (i128)q * d0 + (i128)r * e0;
+    // 하위 62비트가 0 이 되도록 md, me 보정
+    md -= (int64_t)((Fr_qInv62 * (uint64_t)cd + (uint64_t)md) & M62);
+    me -= (int64_t)((Fr_qInv62 * (uint64_t)ce + (uint64_t)me) & M62);
+    cd += (i128)p[0] * md;
+    ce += (i128)p[0] * me;
+    cd >>= 62;
+    ce >>= 62;
+    cd += (i128)u * d1 + (i128)v * e1 + (i128)p[1] * md;
+    ce += (i128)q * d1 + (i128)r * e1 + (i128)p[1] * me;
+    d.v[0] = (int64_t)((uint64_t)cd & M62); cd >>= 62;
+    e.v[0] = (int64_t)((uint64_t)ce & M62); ce >>= 62;
+    cd += (i128)u * d2 + (i128)v * e2 + (i128)p[2] * md;
+    ce += (i128)q * d2 + (i128)r * e2 + (i128)p[2] * me;
+    d.v[1] = (int64_t)((uint64_t)cd & M62); cd >>= 62;
+    e.v[1] = (int64_t)((uint64_t)ce & M62); ce >>= 62;
+    cd += (i128)u * d3 + (i128)v * e3 + (i128)p[3] * md;
+    ce += (i128)q * d3 + (i128)r * e3 + (i128)p[3] * me;
+    d.v[2] = (int64_t)((uint64_t)cd & M62); cd >>= 62;
+    e.v[2] = (int64_t)((uint64_t)ce & M62); ce >>= 62;
+    cd += (i128)u * d4 + (i128)v * e4 + (i128)p[4] * md;
+    ce += (i128)q * d4 + (i128)r * e4 + (i128)p[4] * me;
+    d.v[3] = (int64_t)((uint64_t)cd & M62); cd >>= 62;
+    e.v[3] = (int64_t)((uint64_t)ce & M62); ce >>= 62;
+    d.v[4] = (int64_t)cd;
+    e.v[4] = (int64_t)ce;
+}
+
+// [f, g] <- t * [f, g] / 2^62
+static void updateFG62(FrSigned62 &f, FrSigned62 &g, const FrTrans2x2 &t) {
+    const int64_t f0 = f.v[0], f1 = f.v[1], f2 = f.v[2], f3 = f.v[3], f4 = f.v[4];
+    const int64_t g0 = g.v[0], g1 = g.v[1], g2 = g.v[2], g3 = g.v[3], g4 = g.v[4];
+    const int64_t u = t.u, v = t.v, q = t.q, r = t.r;
+    i128 cf, cg;
+    cf = (i128)u * f0 + (i128)v * g0;
+    cg = (i128)q * f0 + (i128)r * g0;
+    cf >>= 62;
+    cg >>= 62;
+    cf += (i128)u * f1 + (i128)v * g1;
+    cg += (i128)q * f1 + (i128)r * g1;
+    f.v[0] = (int64_t)((uint64_t)cf & M62); cf >>= 62;
+    g.v[0] = (int64_t)((uint64_t)cg & M62); cg >>= 62;
+    cf += (i128)u * f2 + (i128)v * g2;
+    cg += (i128)q * f2 + (i128)r * g2;
+    f.v[1] = (int64_t)((uint64_t)cf & M62); cf >>= 62;
+    g.v[1] = (int64_t)((uint64_t)cg & M62); cg >>= 62;
+    cf += (i128)u * f3 + (i128)v * g3;
+    cg += (i128)q * f3 + (i128)r * g3;
+    f.v[2] = (int64_t)((uint64_t)cf & M62); cf >>= 62;
+    g.v[2] = (int64_t)((uint64_t)cg & M62); cg >>= 62;
+    cf += (i128)u * f4 + (i128)v * g4;
+    cg += (i128)q * f4 + (i128)r * g4;
+    f.v[3] = (int64_t)((uint64_t)cf & M62); cf >>= 62;
+    g.v[3] = (int64_t)((uint64_t)cg & M62); cg >>= 62;
+    f.v[4] = (int64_t)cf;
+    g.v[4] = (int64_t)cg;
+}
+
+// (-2q, q) 범위의 r 을 sign 이 음수이면 부호를 뒤집어 [0, q) 로 정규화
+static void normalize62(FrSigned62 &r, int64_t sign) {
+    const int64_t m62 = (int64_t)M62;
+    const int64_t *p = Fr_q62.v;
+    int64_t r0 = r.v[0], r1 = r.v[1], r2 = r.v[2], r3 = r.v[3], r4 = r.v[4];
+    int64_t condAdd, condNegate;
+
+    condAdd = r4 >> 63;
+    r0 += p[0] & condAdd;
+    r1 += p[1] & condAdd;
+    r2 += p[2] & condAdd;
+    r3 += p[3] & condAdd;
+    r4 += p[4] & condAdd;
+    condNegate = sign >> 63;
+    r0 = (r0 ^ condNegate) - condNegate;
+    r1 = (r1 ^ condNegate) - condNegate;
+    r2 = (r2 ^ condNegate) - condNegate;
+    r3 = (r3 ^ condNegate) - condNegate;
+    r4 = (r4 ^ condNegate) - condNegate;
+    r1 += r0 >> 62; r0 &= m62;
+    r2 += r1 >> 62; r1 &= m62;
+    r3 += r2 >> 62; r2 &= m62;
+    r4 += r3 >> 62; r3 &= m62;
+
+    condAdd = r4 >> 63;
+    r0 += p[0] & condAdd;
+    r1 += p[1] & condAdd;
+    r2 += p[2] & condAdd;
+    r3 += p[3] & condAdd;
+    r4 += p[4] & condAdd;
+    r1 += r0 >> 62; r0 &= m62;
+    r2 += r1 >> 62; r1 &= m62;
+    r3 += r2 >> 62; r2 &= m62;
+    r4 += r3 >> 62; r3 &= m62;
+
+    r.v[0] = r0; r.v[1] = r1; r.v[2] = r2; r.v[3] = r3; r.v[4] = r4;
+}
+
+// 일반 형식 a 의 역원 (a = 0 이면 0)
+static void rawInvNormal(FrRawElement r, const FrRawElement a) {
+    FrSigned62 d = {{0, 0, 0, 0, 0}};
+    FrSigned62 e = {{1, 0, 0, 0, 0}};
+    FrSigned62 f = Fr_q62;
+    FrSigned62 g;
+    toSigned62(g, a);
+    int64_t zeta = -1;
+    for (int i = 0; i < 10; i++) {
+        FrTrans2x2 t;
+        zeta = divsteps59(zeta, (uint64_t)f.v[0], (uint64_t)g.v[0], t);
+        updateDE62(d, e, t);
+        updateFG62(f, g, t);
+    }
+    // 이제 g = 0, f = +-1 이고 d = +-a^-1
+    normalize62(d, f.v[4]);
+    fromSigned62(r, d);
+}
+
+// Montgomery 형식 aR 의 역원 a^-1 R. 정수 역원 a^-1 R^-1 에 R^3 을 Montgomery 곱한다.
+void Fr_rawInv(FrRawElement pRawResult, const FrRawElement pRawA) {
+    FrRawElement t;
+    rawInvNormal(t, pRawA);
+    Fr_rawMMul(pRawResult, t, Fr_R3.longVal);
+}
+
+// 정수 값을 [0, q) 범위의 일반 형식 limb 로 (음수는 q - |v|)
+static inline void rawFromShort(FrRawElement r, int64_t v) {
+    if (v >= 0) {
+        r[0] = (uint64_t)v; r[1] = 0; r[2] = 0; r[3] = 0;
+    } else {
+        FrRawElement a = {0 - (uint64_t)v, 0, 0, 0};
+        Fr_rawNeg(r, a);
+    }
+}
+
+// 원소를 Montgomery 형식 raw 값으로 (Fr_SHORTMONTGOMERY 는 longVal 이 이미 유효)
+static inline void toRawMontgomery(FrRawElement r, PFrElement a) {
+    if (a->type & Fr_MONTGOMERY_BIT) {
+        Fr_rawCopy(r, a->longVal);
+    } else if (a->type & Fr_LONG) {
+        Fr_rawToMontgomery(r, a->longVal);
+    } else {
+        FrRawElement n;
+        rawFromShort(n, a->shortVal);
+        Fr_rawToMontgomery(r, n);
+    }
+}
+
+// 원소를 일반 형식 raw 값으로
+static inline void toRawNormal(FrRawElement r, PFrElement a) {
+    if (!(a->type & Fr_LONG)) {
+        rawFromShort(r, a->shortVal);
+    } else if (a->type & Fr_MONTGOMERY_BIT) {
+        Fr_rawFromMontgomery(r, a->longVal);
     } else {
-        mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)pE->longVal);
+        Fr_rawCopy(r, a->longVal);
     }
 }
 
-void Fr_fromMpz(PFrElement pE, const mpz_t v) {
-    check_init();
-    mpz_t temp; mpz_init_set(temp, v);
-    mpz_mod(temp, temp, q);
-    pE->type = Fr_LONG;
-    memset(pE->longVal, 0, sizeof(pE->longVal));
-    size_t count;
-    mpz_export((void *)(pE->longVal), &count, -1, 8, -1, 0, temp);
-    mpz_clear(temp);
+// -------------------------------------------------------------------------
+// Fr_SHORT fast path: 두 피연산자가 모두 short 이면 64비트 정수 연산으로 처리하고,
+// 결과가 int32 범위를 벗어날 때만 long(Montgomery) 으로 승격한다.
+// -------------------------------------------------------------------------
+
+#ifdef FR_PATH_STATS
+static std::atomic<uint64_t> pathStats[Fr_OP_COUNT][Fr_PATH_COUNT];
+#define FR_COUNT_PATH(op, path) pathStats[op][path].fetch_add(1, std::memory_order_relaxed)
+#else
+#define FR_COUNT_PATH(op, path) ((void)0)
+#endif
+
+void Fr_getPathStats(uint64_t stats[Fr_OP_COUNT][Fr_PATH_COUNT]) {
+    for (int op = 0; op < Fr_OP_COUNT; op++) {
+        for (int path = 0; path < Fr_PATH_COUNT; path++) {
+#ifdef FR_PATH_STATS
+            stats[op][path] = pathStats[op][path].load(std::memory_order_relaxed);
+#else
+            stats[op][path] = 0;
+#endif
+        }
+    }
+}
+
+void Fr_resetPathStats() {
+#ifdef FR_PATH_STATS
+    for (int op = 0; op < Fr_OP_COUNT; op++) {
+        for (int path = 0; path < Fr_PATH_COUNT; path++) {
+            pathStats[op][path].store(0, std::memory_order_relaxed);
+        }
+    }
+#endif
+}
+
+static inline bool bothShort(PFrElement a, PFrElement b) {
+    return !((a->type | b->type) & Fr_LONG);
+}
+
+// int64 결과를 short 로 저장하거나, 범위를 넘으면 Fr_LONGMONTGOMERY 로 승격
+static inline void setFromInt64(PFrElement r, int64_t v, int op) {
+    (void)op;  // FR_PATH_STATS 가 꺼져 있으면 쓰이지 않는다
+    if (v >= INT32_MIN && v <= INT32_MAX) {
+        FR_COUNT_PATH(op, Fr_PATH_SHORT);
+        r->shortVal = (int32_t)v;
+        r->type = Fr_SHORT;
+        return;
+    }
+    FR_COUNT_PATH(op, Fr_PATH_PROMOTE);
+    FrRawElement n;
+    rawFromShort(n, v);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawToMontgomery(r->longVal, n);
 }
 
 void Fr_copy(PFrElement r, PFrElement a) {
@@ -65,151 +399,936 @@ void Fr_copy(PFrElement r, PFrElement a) {
     memcpy(r->longVal, a->longVal, sizeof(r->longVal));
 }
 
-void Fr_toNormal(PFrElement r, PFrElement a) { Fr_copy(r, a); }
+void Fr_toNormal(PFrElement r, PFrElement a) {
+    if (a->type == Fr_LONGMONTGOMERY) {
+        r->shortVal = 0;
+        r->type = Fr_LONG;
+        Fr_rawFromMontgomery(r->longVal, a->longVal);
+    } else {
+        Fr_copy(r, a);
+    }
+}
 
 void Fr_toLongNormal(PFrElement r, PFrElement a) {
-    mpz_t m; mpz_init(m);
-    Fr_toMpz(m, a);
-    Fr_fromMpz(r, m);
-    mpz_clear(m);
+    FrRawElement n;
+    toRawNormal(n, a);
+    r->shortVal = 0;
+    r->type = Fr_LONG;
+    Fr_rawCopy(r->longVal, n);
 }
 
+void Fr_toMontgomery(PFrElement r, PFrElement a) {
+    if (a->type & Fr_MONTGOMERY_BIT) {
+        Fr_copy(r, a);
+    } else if (a->type & Fr_LONG) {
+        r->shortVal = 0;
+        r->type = Fr_LONGMONTGOMERY;
+        Fr_rawToMontgomery(r->longVal, a->longVal);
+    } else {
+        r->shortVal = a->shortVal;
+        r->type = Fr_SHORTMONTGOMERY;
+        toRawMontgomery(r->longVal, a);
+    }
+}
+
+// -------------------------------------------------------------------------
+// 산술 연산: 결과는 항상 Fr_LONGMONTGOMERY
+// -------------------------------------------------------------------------
+
 void Fr_mul(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma, mb, mr; mpz_init(ma); mpz_init(mb); mpz_init(mr);
-    Fr_toMpz(ma, a); Fr_toMpz(mb, b);
-    mpz_mul(mr, ma, mb); mpz_mod(mr, mr, q);
-    Fr_fromMpz(r, mr);
-    mpz_clear(ma); mpz_clear(mb); mpz_clear(mr);
+    CIRCOM_PROF_OP(Circom_PROF_MUL);
+    if (bothShort(a, b)) {
+        setFromInt64(r, (int64_t)a->shortVal * b->shortVal, Fr_OP_MUL);
+        return;
+    }
+    FR_COUNT_PATH(Fr_OP_MUL, Fr_PATH_LONG);
+    FrRawElement ra, rb;
+    toRawMontgomery(ra, a);
+    toRawMontgomery(rb, b);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawMMul(r->longVal, ra, rb);
+}
+
+// -------------------------------------------------------------------------
+// 오류 채널: 0 으로 나누기 등은 프로세스를 종료하지 않고 스레드별 오류 코드로 알린다
+// -------------------------------------------------------------------------
+
+static thread_local int lastError = Fr_OK;
+
+int Fr_getError() {
+    return lastError;
+}
+
+void Fr_setError(int err) {
+    lastError = err;
+}
+
+void Fr_clearError() {
+    lastError = Fr_OK;
+}
+
+static inline bool rawIsZero(const FrRawElement a) {
+    return FrField::isZero(a);
 }
 
+// 0 의 역원은 0 을 돌려주고 Fr_ERR_DIV_BY_ZERO 를 기록한다
 void Fr_inv(PFrElement r, PFrElement a) {
-    mpz_t ma, mr; mpz_init(ma); mpz_init(mr);
-    Fr_toMpz(ma, a);
-    mpz_invert(mr, ma, q);
-    Fr_fromMpz(r, mr);
-    mpz_clear(ma); mpz_clear(mr);
+    CIRCOM_PROF_OP(Circom_PROF_INV);
+    FrRawElement ra;
+    toRawMontgomery(ra, a);
+    if (rawIsZero(ra)) lastError = Fr_ERR_DIV_BY_ZERO;
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawInv(r->longVal, ra);
 }
 
 void Fr_div(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma, mb, mr; mpz_init(ma); mpz_init(mb); mpz_init(mr);
-    Fr_toMpz(ma, a); Fr_toMpz(mb, b);
-    if (mpz_invert(mb, mb, q) == 0) { LOGE("Division by zero"); exit(1); }
-    mpz_mul(mr, ma, mb); mpz_mod(mr, mr, q);
-    Fr_fromMpz(r, mr);
-    mpz_clear(ma); mpz_clear(mb); mpz_clear(mr);
+    CIRCOM_PROF_OP(Circom_PROF_DIV);
+    FrRawElement ra, rb, rinv;
+    toRawMontgomery(ra, a);
+    toRawMontgomery(rb, b);
+    // 0 으로 나누기는 오류 값으로만 알린다 (호출 쪽이 Fr_getError 로 확인). 나눌 때마다 찍히므로 VERBOSE
+    if (rawIsZero(rb)) {
+        LOGV("Division by zero");
+        lastError = Fr_ERR_DIV_BY_ZERO;
+    }
+    Fr_rawInv(rinv, rb);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawMMul(r->longVal, ra, rinv);
+}
+
+// Fr_batchInv 가 한 번에 처리하는 원소 수. 원래 값을 스택에 두므로 (8KB) 힙 할당이 없고,
+// 역원 1번이 256 개에 나뉘므로 원소당 추가 비용은 곱셈 1번 남짓이다
+#define FR_BATCH_INV_CHUNK 256
+
+static int batchInvChunk(PFrElement r, PFrElement a, int n) {
+    int zeros = 0;
+    uint64_t vals[FR_BATCH_INV_CHUNK * Fr_N64];
+    for (int i = 0; i < n; i++) toRawMontgomery(&vals[i * Fr_N64], &a[i]);
+
+    // r[i] 에 0 이 아닌 원소들의 prefix 곱을 임시로 저장
+    FrRawElement acc;
+    Fr_rawCopy(acc, Fr_rawOne);
+    for (int i = 0; i < n; i++) {
+        const uint64_t *v = &vals[i * Fr_N64];
+        if (!rawIsZero(v)) Fr_rawMMul(acc, acc, v);
+        else zeros++;
+        Fr_rawCopy(r[i].longVal, acc);
+    }
+
+    FrRawElement inv;
+    Fr_rawInv(inv, acc);
+    for (int i = n - 1; i >= 0; i--) {
+        const uint64_t *v = &vals[i * Fr_N64];
+        r[i].shortVal = 0;
+        r[i].type = Fr_LONGMONTGOMERY;
+        if (rawIsZero(v)) {
+            memset(r[i].longVal, 0, sizeof(r[i].longVal));
+            continue;
+        }
+        Fr_rawMMul(r[i].longVal, inv, i > 0 ? r[i - 1].longVal : Fr_rawOne);
+        Fr_rawMMul(inv, inv, v);
+    }
+    return zeros;
+}
+
+// Montgomery trick: FR_BATCH_INV_CHUNK 개마다 역원 1번 + 곱셈 3(n-1)번으로 n 개의 역원을 구한다.
+// 0 인 원소의 결과는 0 이고 오류로 기록하지 않는 대신 0 의 개수를 돌려준다.
+// r 과 a 는 같은 배열이어도 된다.
+int Fr_batchInv(PFrElement r, PFrElement a, int n) {
+    CIRCOM_PROF_OPS(Circom_PROF_INV, n > 0 ? n : 0);
+    int zeros = 0;
+    for (int i = 0; i < n; i += FR_BATCH_INV_CHUNK) {
+        int m = n - i < FR_BATCH_INV_CHUNK ? n - i : FR_BATCH_INV_CHUNK;
+        zeros += batchInvChunk(r + i, a + i, m);
+    }
+    return zeros;
 }
 
 void Fr_add(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma, mb, mr; mpz_init(ma); mpz_init(mb); mpz_init(mr);
-    Fr_toMpz(ma, a); Fr_toMpz(mb, b);
-    mpz_add(mr, ma, mb); mpz_mod(mr, mr, q);
-    Fr_fromMpz(r, mr);
-    mpz_clear(ma); mpz_clear(mb); mpz_clear(mr);
+    CIRCOM_PROF_OP(Circom_PROF_ADD);
+    if (bothShort(a, b)) {
+        setFromInt64(r, (int64_t)a->shortVal + b->shortVal, Fr_OP_ADD);
+        return;
+    }
+    FR_COUNT_PATH(Fr_OP_ADD, Fr_PATH_LONG);
+    FrRawElement ra, rb;
+    toRawMontgomery(ra, a);
+    toRawMontgomery(rb, b);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawAdd(r->longVal, ra, rb);
 }
 
 void Fr_sub(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma, mb, mr; mpz_init(ma); mpz_init(mb); mpz_init(mr);
-    Fr_toMpz(ma, a); Fr_toMpz(mb, b);
-    mpz_sub(mr, ma, mb); mpz_mod(mr, mr, q);
-    Fr_fromMpz(r, mr);
-    mpz_clear(ma); mpz_clear(mb); mpz_clear(mr);
+    CIRCOM_PROF_OP(Circom_PROF_SUB);
+    if (bothShort(a, b)) {
+        setFromInt64(r, (int64_t)a->shortVal - b->shortVal, Fr_OP_SUB);
+        return;
+    }
+    FR_COUNT_PATH(Fr_OP_SUB, Fr_PATH_LONG);
+    FrRawElement ra, rb;
+    toRawMontgomery(ra, a);
+    toRawMontgomery(rb, b);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawSub(r->longVal, ra, rb);
 }
 
 void Fr_neg(PFrElement r, PFrElement a) {
-    mpz_t ma, mr; mpz_init(ma); mpz_init(mr);
-    Fr_toMpz(ma, a);
-    mpz_neg(mr, ma); mpz_mod(mr, mr, q);
-    Fr_fromMpz(r, mr);
-    mpz_clear(ma); mpz_clear(mr);
+    CIRCOM_PROF_OP(Circom_PROF_NEG);
+    if (!(a->type & Fr_LONG)) {
+        setFromInt64(r, -(int64_t)a->shortVal, Fr_OP_NEG);
+        return;
+    }
+    FR_COUNT_PATH(Fr_OP_NEG, Fr_PATH_LONG);
+    FrRawElement ra;
+    toRawMontgomery(ra, a);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawNeg(r->longVal, ra);
+}
+
+void Fr_square(PFrElement r, PFrElement a) {
+    CIRCOM_PROF_OP(Circom_PROF_SQUARE);
+    FrRawElement ra;
+    toRawMontgomery(ra, a);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawMSquare(r->longVal, ra);
+}
+
+// -------------------------------------------------------------------------
+// 지연 reduction 누산기: 항들을 R^2 배율의 8 limb 정수로 더하고 마지막에 한 번만 reduce 한다.
+// 곱 aR * bR 은 그대로, 덧셈 항 cR 은 256 비트 올려(cR * R) 같은 배율로 맞춘다.
+// 각 항은 2^510 미만이므로 최상위 비트가 서 있을 때만 중간 fold 하면 넘치지 않는다.
+// -------------------------------------------------------------------------
+
+static inline bool rawLtQ(const FrRawElement a) {
+    const uint64_t *p = Fr_q.longVal;
+    for (int i = Fr_N64 - 1; i >= 0; i--) {
+        if (a[i] != p[i]) return a[i] < p[i];
+    }
+    return false;
 }
 
-void Fr_square(PFrElement r, PFrElement a) { Fr_mul(r, a, a); }
+// 2^512 미만의 T 를 REDC 하여 [0, q) 로 (rawRedc 는 T < qR 일 때만 유효)
+static void accRedc(FrRawElement r, const uint64_t v[8]) {
+    uint64_t t[2 * Fr_N64];
+    memcpy(t, v, sizeof(t));
+    const uint64_t *p = Fr_q.longVal;
+    // 결과는 R + q 미만: redc 가 carry 를 한 번 정리하면 R 미만이고, 남은 q 배수는 최대 5번 더 뺀다
+    rawRedc(r, t);
+    while (!rawLtQ(r)) {
+        uint64_t borrow = 0;
+        r[0] = subb(r[0], p[0], borrow);
+        r[1] = subb(r[1], p[1], borrow);
+        r[2] = subb(r[2], p[2], borrow);
+        r[3] = subb(r[3], p[3], borrow);
+    }
+}
 
-void Fr_str2element(PFrElement pE, char const *s, uint base) {
-    check_init();
-    mpz_t mr; mpz_init_set_str(mr, s, base);
-    mpz_mod(mr, mr, q);
-    Fr_fromMpz(pE, mr);
-    mpz_clear(mr);
+static inline void accAddWide(FrAccumulator *acc, const uint64_t t[8]) {
+    if (acc->v[7] >> 63) {
+        FrRawElement f;
+        accRedc(f, acc->v);
+        acc->v[0] = acc->v[1] = acc->v[2] = acc->v[3] = 0;
+        acc->v[4] = f[0]; acc->v[5] = f[1]; acc->v[6] = f[2]; acc->v[7] = f[3];
+    }
+    uint64_t c = 0;
+    for (int i = 0; i < 2 * Fr_N64; i++) acc->v[i] = addc(acc->v[i], t[i], c);
 }
 
-char *Fr_element2str(PFrElement pE) {
-    mpz_t r; mpz_init(r);
-    Fr_toMpz(r, pE);
-    char *res = mpz_get_str(0, 10, r);
-    mpz_clear(r);
-    return res;
+static inline void rawMulWide(uint64_t t[8], const FrRawElement a, const FrRawElement b) {
+    FrField::mulWide(t, a, b);
+}
+
+void Fr_accInit(FrAccumulator *acc) {
+    memset(acc->v, 0, sizeof(acc->v));
+}
+
+void Fr_accAdd(FrAccumulator *acc, PFrElement a) {
+    CIRCOM_PROF_OP(Circom_PROF_ACC);
+    uint64_t t[2 * Fr_N64] = {0};
+    toRawMontgomery(&t[Fr_N64], a);
+    accAddWide(acc, t);
+}
+
+void Fr_accSub(FrAccumulator *acc, PFrElement a) {
+    CIRCOM_PROF_OP(Circom_PROF_ACC);
+    uint64_t t[2 * Fr_N64] = {0};
+    FrRawElement ra;
+    toRawMontgomery(ra, a);
+    Fr_rawNeg(&t[Fr_N64], ra);
+    accAddWide(acc, t);
+}
+
+void Fr_accMulAdd(FrAccumulator *acc, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_ACC);
+    uint64_t t[2 * Fr_N64];
+    FrRawElement ra, rb;
+    toRawMontgomery(ra, a);
+    toRawMontgomery(rb, b);
+    rawMulWide(t, ra, rb);
+    accAddWide(acc, t);
+}
+
+void Fr_accFinish(PFrElement r, FrAccumulator *acc) {
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    accRedc(r->longVal, acc->v);
+}
+
+// r = a * b + c (reduction 1번). 모두 short 이면 int64 로 계산한다 (|a*b| + |c| < 2^63)
+void Fr_muladd(PFrElement r, PFrElement a, PFrElement b, PFrElement c) {
+    CIRCOM_PROF_OP(Circom_PROF_MULADD);
+    if (bothShort(a, b) && !(c->type & Fr_LONG)) {
+        setFromInt64(r, (int64_t)a->shortVal * b->shortVal + c->shortVal, Fr_OP_MUL);
+        return;
+    }
+    FR_COUNT_PATH(Fr_OP_MUL, Fr_PATH_LONG);
+    uint64_t t[2 * Fr_N64];
+    FrRawElement ra, rb, rc;
+    toRawMontgomery(ra, a);
+    toRawMontgomery(rb, b);
+    toRawMontgomery(rc, c);
+    rawMulWide(t, ra, rb);
+    uint64_t carry = 0;
+    for (int i = 0; i < Fr_N64; i++) t[Fr_N64 + i] = addc(t[Fr_N64 + i], rc[i], carry);
+    // T < q^2 + qR 이므로 REDC 결과는 3q 미만: rawRedc 의 뺄셈 뒤에 한 번 더 뺀다
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    rawRedc(r->longVal, t);
+    rawReduceOnce(r->longVal, 0);
+}
+
+// r += a * b
+void Fr_mulacc(PFrElement r, PFrElement a, PFrElement b) {
+    Fr_muladd(r, a, b, r);
+}
+
+// -------------------------------------------------------------------------
+// 거듭제곱: 지수는 [0, q) 의 정규 값으로 해석한다 (circom `**`)
+// -------------------------------------------------------------------------
+
+#define Fr_POW_WINDOW 4
+
+static inline int rawBit(const FrRawElement e, int i) {
+    return (int)((e[i >> 6] >> (i & 63)) & 1);
+}
+
+// 슬라이딩 윈도우 (w = 4): 홀수 거듭제곱 a^1, a^3, ..., a^15 를 미리 구해 두고
+// 지수를 위에서부터 최대 4비트 창 단위로 소비한다.
+static void rawPow(FrRawElement r, const FrRawElement base, const FrRawElement e) {
+    int top = Fr_N64 * 64 - 1;
+    while (top >= 0 && !rawBit(e, top)) top--;
+    if (top < 0) {
+        Fr_rawCopy(r, Fr_rawOne);
+        return;
+    }
+
+    FrRawElement table[1 << (Fr_POW_WINDOW - 1)];
+    FrRawElement sq;
+    Fr_rawCopy(table[0], base);
+    Fr_rawMSquare(sq, base);
+    for (int k = 1; k < (1 << (Fr_POW_WINDOW - 1)); k++) Fr_rawMMul(table[k], table[k - 1], sq);
+
+    FrRawElement acc;
+    bool started = false;
+    int i = top;
+    while (i >= 0) {
+        if (!rawBit(e, i)) {
+            Fr_rawMSquare(acc, acc);
+            i--;
+            continue;
+        }
+        // i 부터 아래로 최대 w 비트, 마지막 비트가 1 인 창
+        int j = i - Fr_POW_WINDOW + 1;
+        if (j < 0) j = 0;
+        while (!rawBit(e, j)) j++;
+        int window = 0;
+        for (int k = i; k >= j; k--) window = (window << 1) | rawBit(e, k);
+        if (started) {
+            for (int k = i; k >= j; k--) Fr_rawMSquare(acc, acc);
+            Fr_rawMMul(acc, acc, table[window >> 1]);
+        } else {
+            Fr_rawCopy(acc, table[window >> 1]);
+            started = true;
+        }
+        i = j - 1;
+    }
+    Fr_rawCopy(r, acc);
+}
+
+// x^5: Poseidon S-box (제곱 2번 + 곱셈 1번)
+void Fr_pow5(PFrElement r, PFrElement a) {
+    CIRCOM_PROF_OP(Circom_PROF_POW);
+    FrRawElement x, x2;
+    toRawMontgomery(x, a);
+    Fr_rawMSquare(x2, x);
+    Fr_rawMSquare(x2, x2);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawMMul(r->longVal, x2, x);
+}
+
+// x^65537 = x^(2^16 + 1): RSA e = 65537 (제곱 16번 + 곱셈 1번)
+void Fr_pow65537(PFrElement r, PFrElement a) {
+    CIRCOM_PROF_OP(Circom_PROF_POW);
+    FrRawElement x, t;
+    toRawMontgomery(x, a);
+    Fr_rawMSquare(t, x);
+    for (int i = 1; i < 16; i++) Fr_rawMSquare(t, t);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    Fr_rawMMul(r->longVal, t, x);
+}
+
+void Fr_pow(PFrElement r, PFrElement a, PFrElement b) {
+    // 자주 쓰는 작은 상수 지수는 고정 덧셈 사슬로
+    if (!(b->type & Fr_LONG)) {
+        switch (b->shortVal) {
+            case 1: Fr_copy(r, a); return;
+            case 2: Fr_square(r, a); return;
+            case 5: Fr_pow5(r, a); return;
+            case 65537: Fr_pow65537(r, a); return;
+            default: break;
+        }
+    }
+    CIRCOM_PROF_OP(Circom_PROF_POW);
+    FrRawElement x, e;
+    toRawMontgomery(x, a);
+    toRawNormal(e, b);
+    r->shortVal = 0;
+    r->type = Fr_LONGMONTGOMERY;
+    rawPow(r->longVal, x, e);
 }
 
-void Fr_idiv(PFrElement r, PFrElement a, PFrElement b) { Fr_div(r, a, b); }
-void Fr_mod(PFrElement r, PFrElement a, PFrElement b) { if (r == nullptr) return; Fr_copy(r, a); }
-void Fr_pow(PFrElement r, PFrElement a, PFrElement b) {}
 void Fr_fail() { assert(false); }
 
-// 🔥 [핵심 수정] GMP 할당 없이 빠르고 안전하게 비교
-void Fr_eq(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma, mb; mpz_init(ma); mpz_init(mb);
-    Fr_toMpz(ma, a); Fr_toMpz(mb, b);
+// -------------------------------------------------------------------------
+// 비교 / 정수 변환: limb 위에서 직접 (GMP 할당 없음)
+// circom 의미론을 따라 대소 비교와 Fr_toInt 는 z > q/2 인 값을 음수 z - q 로 본다.
+// -------------------------------------------------------------------------
 
-    r->type = Fr_SHORT;
-    if (mpz_cmp(ma, mb) == 0) {
-        r->shortVal = 1;
-    } else {
-        r->shortVal = 0;
+// (q - 1) / 2
+static const uint64_t *const Fr_rawHalfQ = FrField::halfQ.v;
+
+static inline bool rawGt(const FrRawElement a, const FrRawElement b) {
+    for (int i = Fr_N64 - 1; i >= 0; i--) {
+        if (a[i] != b[i]) return a[i] > b[i];
     }
-    // 안전을 위해 longVal 초기화
+    return false;
+}
+
+static inline bool rawEq(const FrRawElement a, const FrRawElement b) {
+    return FrField::eq(a, b);
+}
+
+// Montgomery 형식도 0 은 0 이므로 형식 변환 없이 판별할 수 있다
+static inline bool elementIsZero(PFrElement a) {
+    if (!(a->type & Fr_LONG)) return a->shortVal == 0;
+    return rawIsZero(a->longVal);
+}
+
+static inline bool shortNonNeg(PFrElement a) {
+    return !(a->type & Fr_LONG) && a->shortVal >= 0;
+}
+
+static inline void setBool(PFrElement r, bool v) {
+    r->shortVal = v;
+    r->type = Fr_SHORT;
     memset(r->longVal, 0, sizeof(r->longVal));
+}
+
+static bool elementEq(PFrElement a, PFrElement b) {
+    // 둘 다 Montgomery 값을 갖고 있으면 ([0, q) 로 유일하므로) 그대로 비교
+    if ((a->type & b->type & Fr_MONTGOMERY_BIT) != 0) return rawEq(a->longVal, b->longVal);
+    FrRawElement ra, rb;
+    toRawNormal(ra, a);
+    toRawNormal(rb, b);
+    return rawEq(ra, rb);
+}
 
-    mpz_clear(ma); mpz_clear(mb);
+// 부호 있는 값 (z > q/2 이면 z - q) 기준 a < b
+static bool elementLt(PFrElement a, PFrElement b) {
+    FrRawElement ra, rb;
+    toRawNormal(ra, a);
+    toRawNormal(rb, b);
+    bool negA = rawGt(ra, Fr_rawHalfQ);
+    bool negB = rawGt(rb, Fr_rawHalfQ);
+    if (negA != negB) return negA;
+    return rawGt(rb, ra);
+}
+
+void Fr_eq(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_CMP);
+    if (bothShort(a, b)) {
+        FR_COUNT_PATH(Fr_OP_CMP, Fr_PATH_SHORT);
+        setBool(r, a->shortVal == b->shortVal);
+        return;
+    }
+    FR_COUNT_PATH(Fr_OP_CMP, Fr_PATH_LONG);
+    setBool(r, elementEq(a, b));
 }
 
-// 🔥 [핵심 수정] Fr_neg를 쓰지 않고 단순 논리 반전 (메모리 문제 해결)
 void Fr_neq(PFrElement r, PFrElement a, PFrElement b) {
-    Fr_eq(r, a, b);
+    CIRCOM_PROF_OP(Circom_PROF_CMP);
+    if (bothShort(a, b)) {
+        FR_COUNT_PATH(Fr_OP_CMP, Fr_PATH_SHORT);
+        setBool(r, a->shortVal != b->shortVal);
+        return;
+    }
+    FR_COUNT_PATH(Fr_OP_CMP, Fr_PATH_LONG);
+    setBool(r, !elementEq(a, b));
+}
 
-    // eq 결과가 1이면 0으로, 0이면 1로 뒤집기
-    if (r->shortVal != 0) {
-        r->shortVal = 0;
-    } else {
-        r->shortVal = 1;
+void Fr_lt(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_CMP);
+    if (bothShort(a, b)) {
+        FR_COUNT_PATH(Fr_OP_CMP, Fr_PATH_SHORT);
+        setBool(r, a->shortVal < b->shortVal);
+        return;
     }
-    // 타입과 메모리 확실히 정리
-    r->type = Fr_SHORT;
-    memset(r->longVal, 0, sizeof(r->longVal));
+    FR_COUNT_PATH(Fr_OP_CMP, Fr_PATH_LONG);
+    setBool(r, elementLt(a, b));
 }
 
 int Fr_isTrue(PFrElement pE) {
-    return Fr_toInt(pE) != 0;
+    if (!(pE->type & Fr_LONG)) return pE->shortVal != 0;
+    const uint64_t *v = pE->longVal;
+    return (v[0] | v[1] | v[2] | v[3]) != 0;
 }
 
-void Fr_lt(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma, mb; mpz_init(ma); mpz_init(mb);
-    Fr_toMpz(ma, a); Fr_toMpz(mb, b);
-    r->type = Fr_SHORT;
-    if (mpz_cmp(ma, mb) < 0) {
-        r->shortVal = 1;
+// int32 범위를 벗어나면 Fr_ERR_TOINT 를 기록하고 하위 32비트를 돌려준다
+int Fr_toInt(PFrElement pE) {
+    if (!(pE->type & Fr_LONG)) return pE->shortVal;
+    FrRawElement v;
+    toRawNormal(v, pE);
+    bool neg = rawGt(v, Fr_rawHalfQ);
+    if (neg) Fr_rawNeg(v, v);
+    uint64_t limit = neg ? (uint64_t)INT32_MAX + 1 : (uint64_t)INT32_MAX;
+    if ((v[1] | v[2] | v[3]) != 0 || v[0] > limit) {
+        Fr_setError(Fr_ERR_TOINT);
+    }
+    return neg ? (int32_t)(0 - (uint32_t)v[0]) : (int32_t)v[0];
+}
+
+// -------------------------------------------------------------------------
+// 정수 나눗셈 / 나머지: [0, q) 정규 값을 정수로 보고 계산한다 (circom `\` , `%`)
+// -------------------------------------------------------------------------
+
+// 254 비트 shift-subtract 나눗셈 (b != 0)
+static void rawDivMod(FrRawElement quot, FrRawElement rem, const FrRawElement a, const FrRawElement b) {
+    FrRawElement qt = {0, 0, 0, 0}, rm = {0, 0, 0, 0};
+    for (int i = 253; i >= 0; i--) {
+        rm[3] = (rm[3] << 1) | (rm[2] >> 63);
+        rm[2] = (rm[2] << 1) | (rm[1] >> 63);
+        rm[1] = (rm[1] << 1) | (rm[0] >> 63);
+        rm[0] = (rm[0] << 1) | ((a[i >> 6] >> (i & 63)) & 1);
+        if (!rawGt(b, rm)) {
+            uint64_t borrow = 0;
+            rm[0] = subb(rm[0], b[0], borrow);
+            rm[1] = subb(rm[1], b[1], borrow);
+            rm[2] = subb(rm[2], b[2], borrow);
+            rm[3] = subb(rm[3], b[3], borrow);
+            qt[i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+    Fr_rawCopy(quot, qt);
+    Fr_rawCopy(rem, rm);
+}
+
+// 정규 값을 저장: int32 에 들어가면 Fr_SHORT, 아니면 Fr_LONG
+static inline void setNormal(PFrElement r, const FrRawElement v) {
+    if ((v[1] | v[2] | v[3]) == 0 && v[0] <= (uint64_t)INT32_MAX) {
+        r->shortVal = (int32_t)v[0];
+        r->type = Fr_SHORT;
+        return;
+    }
+    r->shortVal = 0;
+    r->type = Fr_LONG;
+    Fr_rawCopy(r->longVal, v);
+}
+
+// 0 으로 나누면 결과는 0 이고 Fr_ERR_DIV_BY_ZERO 를 기록한다
+static void divMod(PFrElement r, PFrElement a, PFrElement b, bool wantRem) {
+    if (shortNonNeg(a) && shortNonNeg(b) && b->shortVal != 0) {
+        r->shortVal = wantRem ? a->shortVal % b->shortVal : a->shortVal / b->shortVal;
+        r->type = Fr_SHORT;
+        return;
+    }
+    if (elementIsZero(b)) {
+        Fr_setError(Fr_ERR_DIV_BY_ZERO);
+        setBool(r, false);
+        return;
+    }
+    FrRawElement ra, rb, quot, rem;
+    toRawNormal(ra, a);
+    toRawNormal(rb, b);
+    rawDivMod(quot, rem, ra, rb);
+    setNormal(r, wantRem ? rem : quot);
+}
+
+void Fr_idiv(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_IDIV);
+    divMod(r, a, b, false);
+}
+
+void Fr_mod(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_IDIV);
+    divMod(r, a, b, true);
+}
+
+// -------------------------------------------------------------------------
+// 문자열 <-> 원소 (진법 2/8/10/16, GMP 없음)
+// 숫자를 u64 에 들어가는 덩어리로 읽어 5 limb 정수에 acc = acc * base^k + chunk 로 누적한다.
+// 256비트를 넘을 때만 mod q 로 접으므로 보통 길이 (q 미만) 의 입력은 곱셈 몇 번으로 끝난다.
+// -------------------------------------------------------------------------
+
+static inline int digitValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return 99;
+}
+
+// u64 하나에 들어가는 덩어리 자릿수
+static inline int chunkDigits(uint base) {
+    switch (base) {
+        case 2: return 63;
+        case 8: return 21;
+        case 16: return 15;
+        default: return 19;
+    }
+}
+
+// 2^256 미만의 값을 [0, q) 로 (2^256 < 6q 이므로 최대 5번 뺀다)
+static inline void rawReduceFull(FrRawElement r) {
+    for (int k = 0; k < 5; k++) rawReduceOnce(r, 0);
+}
+
+// t (5 limb) 를 t mod q (4 limb, t[4] = 0) 로 접는다: t4 * 2^256 = t4 * R 을 R^2 와의 Montgomery 곱으로 구한다
+static void foldWide(uint64_t t[Fr_N64 + 1]) {
+    FrRawElement hi = {t[4], 0, 0, 0};
+    Fr_rawMMul(hi, hi, Fr_R2.longVal);
+    rawReduceFull(t);
+    Fr_rawAdd(t, t, hi);
+    t[4] = 0;
+}
+
+int Fr_str2raw(FrRawElement r, const char *s, size_t len, uint base) {
+    r[0] = r[1] = r[2] = r[3] = 0;
+    if (base != 2 && base != 8 && base != 10 && base != 16) return 0;
+    if (len == 0) return 0;
+    int k = chunkDigits(base);
+    size_t n = len % k ? len % k : k;
+    uint64_t t[Fr_N64 + 1] = {0, 0, 0, 0, 0};
+    for (size_t pos = 0; pos < len; pos += n, n = k) {
+        uint64_t chunk = 0, scale = 1;
+        for (size_t i = 0; i < n; i++) {
+            int d = digitValue(s[pos + i]);
+            if (d >= (int)base) return 0;
+            chunk = chunk * base + d;
+            scale *= base;
+        }
+        if (t[4]) foldWide(t);
+        uint64_t c = chunk;
+        for (int i = 0; i < Fr_N64; i++) {
+            u128 uv = (u128)t[i] * scale + c;
+            t[i] = (uint64_t)uv;
+            c = (uint64_t)(uv >> 64);
+        }
+        t[4] = c;
+    }
+    if (t[4]) foldWide(t);
+    else rawReduceFull(t);
+    Fr_rawCopy(r, t);
+    return 1;
+}
+
+// 일반 형식 a ([0, q)) 를 base 진법으로. 끝의 NUL 을 뺀 길이, 버퍼가 모자라면 -1
+int Fr_raw2str(char *buf, size_t size, const FrRawElement a, uint base) {
+    static const char digits[] = "0123456789abcdef";
+    static const char digitPairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+    char tmp[Fr_STR_MAX];
+    int n = 0;
+    if (base == 10) {
+        // 32비트 조각 8개를 10^9 (상수) 로 나눠 가며 9 자리씩 뽑는다. 마지막 덩어리는 앞의 0 생략
+        uint32_t v[2 * Fr_N64];
+        for (int i = 0; i < Fr_N64; i++) {
+            v[2 * i] = (uint32_t)a[i];
+            v[2 * i + 1] = (uint32_t)(a[i] >> 32);
+        }
+        int top = 2 * Fr_N64 - 1;
+        while (top >= 0 && v[top] == 0) top--;
+        while (top >= 0) {
+            uint64_t rem = 0;
+            for (int i = top; i >= 0; i--) {
+                uint64_t cur = (rem << 32) | v[i];
+                v[i] = (uint32_t)(cur / 1000000000U);
+                rem = cur % 1000000000U;
+            }
+            while (top >= 0 && v[top] == 0) top--;
+            uint32_t r9 = (uint32_t)rem;
+            if (top >= 0) {
+                // 중간 덩어리는 항상 9 자리: 두 자리씩 표로 뽑는다
+                for (int i = 0; i < 4; i++) {
+                    uint32_t d2 = (r9 % 100) * 2;
+                    r9 /= 100;
+                    tmp[n++] = digitPairs[d2 + 1];
+                    tmp[n++] = digitPairs[d2];
+                }
+                tmp[n++] = digits[r9];
+            } else {
+                while (r9) {
+                    tmp[n++] = digits[r9 % 10];
+                    r9 /= 10;
+                }
+            }
+        }
     } else {
-        r->shortVal = 0;
+        if (base != 2 && base != 8 && base != 16) return -1;
+        int bits = base == 2 ? 1 : base == 8 ? 3 : 4;
+        int total = Fr_N64 * 64;
+        for (int i = 0; i < total; i += bits) {
+            uint32_t d = 0;
+            for (int b = 0; b < bits && i + b < total; b++) {
+                d |= (uint32_t)((a[(i + b) >> 6] >> ((i + b) & 63)) & 1) << b;
+            }
+            tmp[n++] = digits[d];
+        }
+        while (n > 0 && tmp[n - 1] == '0') n--;
     }
-    memset(r->longVal, 0, sizeof(r->longVal));
-    mpz_clear(ma); mpz_clear(mb);
+    if (n == 0) tmp[n++] = '0';
+    if ((size_t)n + 1 > size) return -1;
+    for (int i = 0; i < n; i++) buf[i] = tmp[n - 1 - i];
+    buf[n] = 0;
+    return n;
 }
 
-int Fr_toInt(PFrElement pE) {
-    if (pE->type & Fr_LONG) {
-        // LONG 타입인데 값이 0이 아닐 확률이 높으므로 1 리턴
-        // 더 정확히 하려면 longVal 검사해야 하지만 보통은 이걸로 충분
-        return 1;
+// 잘못된 문자열이면 값은 0 이고 0 을 돌려준다
+int Fr_str2element(PFrElement pE, char const *s, uint base) {
+    FrRawElement v;
+    int ok = Fr_str2raw(v, s, strlen(s), base);
+    setNormal(pE, v);
+    return ok;
+}
+
+// 결과는 malloc 으로 할당되며 호출한 쪽에서 free 한다
+char *Fr_element2str(PFrElement pE) {
+    FrRawElement v;
+    char buf[Fr_STR_MAX];
+    toRawNormal(v, pE);
+    int n = Fr_raw2str(buf, sizeof(buf), v, 10);
+    char *res = (char *)malloc(n + 1);
+    memcpy(res, buf, n + 1);
+    return res;
+}
+
+// 배열 변환: 잘못된 문자열은 0 으로 두고 그 개수를 돌려준다
+int Fr_str2elementn(PFrElement r, const char *const *s, int n, uint base) {
+    int invalid = 0;
+    for (int i = 0; i < n; i++) {
+        FrRawElement v;
+        if (!Fr_str2raw(v, s[i], strlen(s[i]), base)) invalid++;
+        setNormal(&r[i], v);
+    }
+    return invalid;
+}
+
+void Fr_element2strn(std::string *r, PFrElement a, int n, uint base) {
+    char buf[Fr_STR_MAX];
+    for (int i = 0; i < n; i++) {
+        FrRawElement v;
+        toRawNormal(v, &a[i]);
+        int len = Fr_raw2str(buf, sizeof(buf), v, base);
+        r[i].assign(buf, len);
+    }
+}
+
+// -------------------------------------------------------------------------
+// 비트 / 시프트 / 논리 연산 (circom 의미론)
+// - 비트 연산은 [0, q) 정규 값 위에서 하고, 결과를 254비트로 마스킹한 뒤 mod q
+// - x << k, x >> k 의 k 는 체 원소: k <= q/2 이면 그대로, 아니면 반대 방향으로 q - k 만큼
+// - 결과는 일반 형식이며 int32 에 들어가면 Fr_SHORT 로 돌려준다
+// -------------------------------------------------------------------------
+
+#define Fr_BITS 254
+static const uint64_t Fr_topMask = 0x3fffffffffffffffULL;
+
+// 254비트로 자른 값 (< 2^254 < 2q) 을 정규화해서 저장
+static inline void setMaskedNormal(PFrElement r, FrRawElement v) {
+    v[3] &= Fr_topMask;
+    rawReduceOnce(v, 0);
+    setNormal(r, v);
+}
+
+static void rawShl(FrRawElement r, const FrRawElement a, uint32_t n) {
+    FrRawElement t = {0, 0, 0, 0};
+    if (n < Fr_BITS) {
+        int limbs = n >> 6, bits = n & 63;
+        for (int i = Fr_N64 - 1; i >= limbs; i--) {
+            uint64_t v = a[i - limbs] << bits;
+            if (bits && i - limbs - 1 >= 0) v |= a[i - limbs - 1] >> (64 - bits);
+            t[i] = v;
+        }
+    }
+    Fr_rawCopy(r, t);
+}
+
+static void rawShr(FrRawElement r, const FrRawElement a, uint32_t n) {
+    FrRawElement t = {0, 0, 0, 0};
+    if (n < Fr_BITS) {
+        int limbs = n >> 6, bits = n & 63;
+        for (int i = 0; i + limbs < Fr_N64; i++) {
+            uint64_t v = a[i + limbs] >> bits;
+            if (bits && i + limbs + 1 < Fr_N64) v |= a[i + limbs + 1] << (64 - bits);
+            t[i] = v;
+        }
+    }
+    Fr_rawCopy(r, t);
+}
+
+// 시프트 양 k 를 (왼쪽이면 true, 칸 수) 로 해석. 칸 수가 Fr_BITS 이상이면 Fr_BITS 로 자른다.
+static inline void shiftAmount(PFrElement b, bool &left, uint32_t &n) {
+    if (!(b->type & Fr_LONG)) {
+        int64_t k = b->shortVal;
+        left = k >= 0;
+        uint64_t m = k >= 0 ? (uint64_t)k : (uint64_t)(-k);
+        n = m > Fr_BITS ? Fr_BITS : (uint32_t)m;
+        return;
+    }
+    FrRawElement k;
+    toRawNormal(k, b);
+    left = !rawGt(k, Fr_rawHalfQ);
+    if (!left) Fr_rawNeg(k, k);
+    bool big = (k[1] | k[2] | k[3]) != 0 || k[0] > Fr_BITS;
+    n = big ? Fr_BITS : (uint32_t)k[0];
+}
+
+static void shiftElement(PFrElement r, PFrElement a, bool left, uint32_t n) {
+    // short 빠른 경로: 음이 아닌 short 를 오른쪽으로, 또는 int32 를 넘지 않게 왼쪽으로
+    if (shortNonNeg(a)) {
+        uint64_t v = (uint64_t)a->shortVal;
+        if (!left) {
+            r->shortVal = n >= 32 ? 0 : (int32_t)(v >> n);
+            r->type = Fr_SHORT;
+            return;
+        }
+        if (n < 32 && (v << n) <= (uint64_t)INT32_MAX) {
+            r->shortVal = (int32_t)(v << n);
+            r->type = Fr_SHORT;
+            return;
+        }
+    }
+    FrRawElement x;
+    toRawNormal(x, a);
+    if (left) rawShl(x, x, n);
+    else rawShr(x, x, n);
+    setMaskedNormal(r, x);
+}
+
+void Fr_shl(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_SHIFT);
+    bool left;
+    uint32_t n;
+    shiftAmount(b, left, n);
+    shiftElement(r, a, left, n);
+}
+
+void Fr_shr(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_SHIFT);
+    bool left;
+    uint32_t n;
+    shiftAmount(b, left, n);
+    shiftElement(r, a, !left, n);
+}
+
+void Fr_band(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_BIT);
+    if (shortNonNeg(a) && shortNonNeg(b)) {
+        r->shortVal = a->shortVal & b->shortVal;
+        r->type = Fr_SHORT;
+        return;
+    }
+    FrRawElement x, y;
+    toRawNormal(x, a);
+    toRawNormal(y, b);
+    for (int i = 0; i < Fr_N64; i++) x[i] &= y[i];
+    setMaskedNormal(r, x);
+}
+
+void Fr_bor(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_BIT);
+    if (shortNonNeg(a) && shortNonNeg(b)) {
+        r->shortVal = a->shortVal | b->shortVal;
+        r->type = Fr_SHORT;
+        return;
+    }
+    FrRawElement x, y;
+    toRawNormal(x, a);
+    toRawNormal(y, b);
+    for (int i = 0; i < Fr_N64; i++) x[i] |= y[i];
+    setMaskedNormal(r, x);
+}
+
+void Fr_bxor(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_BIT);
+    if (shortNonNeg(a) && shortNonNeg(b)) {
+        r->shortVal = a->shortVal ^ b->shortVal;
+        r->type = Fr_SHORT;
+        return;
     }
-    return pE->shortVal;
+    FrRawElement x, y;
+    toRawNormal(x, a);
+    toRawNormal(y, b);
+    for (int i = 0; i < Fr_N64; i++) x[i] ^= y[i];
+    setMaskedNormal(r, x);
+}
+
+void Fr_bnot(PFrElement r, PFrElement a) {
+    CIRCOM_PROF_OP(Circom_PROF_BIT);
+    FrRawElement x;
+    toRawNormal(x, a);
+    for (int i = 0; i < Fr_N64; i++) x[i] = ~x[i];
+    setMaskedNormal(r, x);
+}
+
+void Fr_land(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_LOGIC);
+    r->shortVal = !elementIsZero(a) && !elementIsZero(b);
+    r->type = Fr_SHORT;
+}
+
+void Fr_lor(PFrElement r, PFrElement a, PFrElement b) {
+    CIRCOM_PROF_OP(Circom_PROF_LOGIC);
+    r->shortVal = !elementIsZero(a) || !elementIsZero(b);
+    r->type = Fr_SHORT;
 }
 
-// Raw 함수들 (더미 유지)
-void Fr_rawCopy(FrRawElement pRawResult, const FrRawElement pRawA) { memcpy(pRawResult, pRawA, 32); }
-void Fr_rawAdd(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) { memcpy(pRawResult, pRawA, 32); }
-void Fr_rawSub(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) { memcpy(pRawResult, pRawA, 32); }
-void Fr_rawNeg(FrRawElement pRawResult, const FrRawElement pRawA) { memcpy(pRawResult, pRawA, 32); }
-void Fr_rawMMul(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) { memcpy(pRawResult, pRawA, 32); }
-void Fr_rawMSquare(FrRawElement pRawResult, const FrRawElement pRawA) { memcpy(pRawResult, pRawA, 32); }
+void Fr_lnot(PFrElement r, PFrElement a) {
+    CIRCOM_PROF_OP(Circom_PROF_LOGIC);
+    r->shortVal = elementIsZero(a);
+    r->type = Fr_SHORT;
+}
+
+void Fr_gt(PFrElement r, PFrElement a, PFrElement b) {
+    Fr_lt(r, b, a);
+}
+
+void Fr_leq(PFrElement r, PFrElement a, PFrElement b) {
+    Fr_lt(r, b, a);
+    r->shortVal = !r->shortVal;
+}
+
+void Fr_geq(PFrElement r, PFrElement a, PFrElement b) {
+    Fr_lt(r, a, b);
+    r->shortVal = !r->shortVal;
+}
 
-static bool init = Fr_init();
\ No newline at end of file
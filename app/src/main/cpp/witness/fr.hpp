@@ -3,7 +3,6 @@
 
 #include <stdint.h>
 #include <string>
-#include <gmp.h>
 
 #ifdef __APPLE__
 #include <sys/types.h>
@@ -12,6 +11,8 @@
 #define Fr_N64 4
 #define Fr_SHORT 0x00000000
 #define Fr_LONG 0x80000000
+#define Fr_SHORTMONTGOMERY 0x40000000
+#define Fr_LONGMONTGOMERY 0xC0000000
 
 typedef uint64_t FrRawElement[Fr_N64];
 
@@ -25,7 +26,13 @@ typedef struct {
 
 typedef FrElement *PFrElement;
 
+// 지연 reduction 누산기 (R^2 배율의 8 limb 정수). Fr_accInit 후 항을 더하고 Fr_accFinish 로 한 번만 reduce
+typedef struct {
+    uint64_t v[2 * Fr_N64];
+} FrAccumulator;
+
 extern FrElement Fr_q;
+extern FrElement Fr_R2;
 extern FrElement Fr_R3;
 
 extern "C" void Fr_copy(PFrElement r, PFrElement a);
@@ -35,6 +42,13 @@ extern "C" void Fr_sub(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_neg(PFrElement r, PFrElement a);
 extern "C" void Fr_mul(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_square(PFrElement r, PFrElement a);
+extern "C" void Fr_muladd(PFrElement r, PFrElement a, PFrElement b, PFrElement c); // r = a * b + c
+extern "C" void Fr_mulacc(PFrElement r, PFrElement a, PFrElement b);               // r += a * b
+extern "C" void Fr_accInit(FrAccumulator *acc);
+extern "C" void Fr_accAdd(FrAccumulator *acc, PFrElement a);
+extern "C" void Fr_accSub(FrAccumulator *acc, PFrElement a);
+extern "C" void Fr_accMulAdd(FrAccumulator *acc, PFrElement a, PFrElement b);
+extern "C" void Fr_accFinish(PFrElement r, FrAccumulator *acc);
 extern "C" void Fr_band(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_bor(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_bxor(PFrElement r, PFrElement a, PFrElement b);
@@ -54,25 +68,63 @@ extern "C" void Fr_toNormal(PFrElement r, PFrElement a);
 extern "C" void Fr_toLongNormal(PFrElement r, PFrElement a);
 extern "C" void Fr_toMontgomery(PFrElement r, PFrElement a);
 
+// 배열 연산: r[i] = a[i] op b[i], i < n (fr_simd.cpp, NEON/AVX2 런타임 선택)
+// r 은 a 나 b 와 같은 배열이어도 되지만 일부만 겹치면 안 된다.
+// 지금은 생성 코드와 런타임 어디에서도 부르지 않는 공개 API 다 (fr-check / fr-bench 만 쓴다).
+extern "C" void Fr_addn(PFrElement r, PFrElement a, PFrElement b, int n);
+extern "C" void Fr_subn(PFrElement r, PFrElement a, PFrElement b, int n);
+extern "C" void Fr_muln(PFrElement r, PFrElement a, PFrElement b, int n);
+extern "C" void Fr_eqn(PFrElement r, PFrElement a, PFrElement b, int n);
+extern "C" const char *Fr_vecKernelName();
+
 extern "C" int Fr_isTrue(PFrElement pE);
 extern "C" int Fr_toInt(PFrElement pE);
 
-// 더미 함수들 (사용 안함)
+// Raw 연산: 4x64 limb, 값은 [0, q) 범위의 Montgomery 형식 (aR mod q)
 extern "C" void Fr_rawCopy(FrRawElement pRawResult, const FrRawElement pRawA);
 extern "C" void Fr_rawAdd(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB);
 extern "C" void Fr_rawSub(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB);
 extern "C" void Fr_rawNeg(FrRawElement pRawResult, const FrRawElement pRawA);
 extern "C" void Fr_rawMMul(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB);
 extern "C" void Fr_rawMSquare(FrRawElement pRawResult, const FrRawElement pRawA);
+extern "C" void Fr_rawToMontgomery(FrRawElement pRawResult, const FrRawElement pRawA);
+extern "C" void Fr_rawFromMontgomery(FrRawElement pRawResult, const FrRawElement pRawA);
+extern "C" void Fr_rawInv(FrRawElement pRawResult, const FrRawElement pRawA);
 
 extern "C" void Fr_fail();
 
-void Fr_str2element(PFrElement pE, char const*s, uint base);
+// 오류 채널 (스레드별). Fr_inv / Fr_div / Fr_idiv / Fr_mod 에 0 이 들어오면 결과는 0, 오류는 Fr_ERR_DIV_BY_ZERO
+// Fr_toInt 의 값이 int32 범위를 벗어나면 Fr_ERR_TOINT
+#define Fr_OK 0
+#define Fr_ERR_DIV_BY_ZERO 1
+#define Fr_ERR_TOINT 2
+extern "C" int Fr_getError();
+extern "C" void Fr_setError(int err);
+extern "C" void Fr_clearError();
+
+// Fr_SHORT fast path 통계 (FR_PATH_STATS 로 빌드했을 때만 집계, 아니면 항상 0)
+enum { Fr_OP_ADD, Fr_OP_SUB, Fr_OP_MUL, Fr_OP_NEG, Fr_OP_CMP, Fr_OP_COUNT };
+enum { Fr_PATH_SHORT, Fr_PATH_PROMOTE, Fr_PATH_LONG, Fr_PATH_COUNT };
+void Fr_getPathStats(uint64_t stats[Fr_OP_COUNT][Fr_PATH_COUNT]);
+void Fr_resetPathStats();
+
+// 문자열 변환 (진법 2/8/10/16, 접두사 없이). 값은 mod q 로 줄이고, 결과는 일반 형식
+// Fr_str2raw 는 잘못된 문자가 있으면 0, Fr_raw2str 는 쓴 길이 (버퍼가 모자라면 -1)
+#define Fr_STR_MAX 256
+extern "C" int Fr_str2raw(FrRawElement r, const char *s, size_t len, uint base);
+extern "C" int Fr_raw2str(char *buf, size_t size, const FrRawElement a, uint base);
+int Fr_str2element(PFrElement pE, char const*s, uint base);
 char *Fr_element2str(PFrElement pE);
+int Fr_str2elementn(PFrElement r, const char *const *s, int n, uint base);
+void Fr_element2strn(std::string *r, PFrElement a, int n, uint base);
 void Fr_div(PFrElement r, PFrElement a, PFrElement b);
 void Fr_idiv(PFrElement r, PFrElement a, PFrElement b);
 void Fr_mod(PFrElement r, PFrElement a, PFrElement b);
 void Fr_inv(PFrElement r, PFrElement a);
+int Fr_batchInv(PFrElement r, PFrElement a, int n);
 void Fr_pow(PFrElement r, PFrElement a, PFrElement b);
+// 상수 지수 전용 (생성 코드가 지수를 알 때 직접 호출 가능, Fr_pow 도 자동으로 사용)
+void Fr_pow5(PFrElement r, PFrElement a);
+void Fr_pow65537(PFrElement r, PFrElement a);
 
 #endif // __FR_H
\ No newline at end of file
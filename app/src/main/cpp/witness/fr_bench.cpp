@@ -0,0 +1,243 @@
+// Fr 연산 마이크로 벤치마크 (WITNESS_BUILD_BENCH=ON 일 때만 빌드)
+// 네이티브 Montgomery 엔진과 기존 GMP mpz 경로(연산마다 import/mod/export)를 비교한다.
+// 사용법: adb push fr-bench /data/local/tmp && adb shell /data/local/tmp/fr-bench [반복 횟수]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <gmp.h>
+#include "fr.hpp"
+
+static mpz_t q;
+
+// 기존 fr.cpp 의 GMP 경로를 그대로 재현
+static void gmp_toMpz(mpz_t r, PFrElement pE) {
+    mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)pE->longVal);
+}
+
+static void gmp_fromMpz(PFrElement pE, const mpz_t v) {
+    mpz_t temp; mpz_init_set(temp, v);
+    mpz_mod(temp, temp, q);
+    pE->type = Fr_LONG;
+    memset(pE->longVal, 0, sizeof(pE->longVal));
+    size_t count;
+    mpz_export((void *)(pE->longVal), &count, -1, 8, -1, 0, temp);
+    mpz_clear(temp);
+}
+
+static void gmp_add(PFrElement r, PFrElement a, PFrElement b) {
+    mpz_t ma, mb, mr; mpz_init(ma); mpz_init(mb); mpz_init(mr);
+    gmp_toMpz(ma, a); gmp_toMpz(mb, b);
+    mpz_add(mr, ma, mb); mpz_mod(mr, mr, q);
+    gmp_fromMpz(r, mr);
+    mpz_clear(ma); mpz_clear(mb); mpz_clear(mr);
+}
+
+static void gmp_sub(PFrElement r, PFrElement a, PFrElement b) {
+    mpz_t ma, mb, mr; mpz_init(ma); mpz_init(mb); mpz_init(mr);
+    gmp_toMpz(ma, a); gmp_toMpz(mb, b);
+    mpz_sub(mr, ma, mb); mpz_mod(mr, mr, q);
+    gmp_fromMpz(r, mr);
+    mpz_clear(ma); mpz_clear(mb); mpz_clear(mr);
+}
+
+static void gmp_mul(PFrElement r, PFrElement a, PFrElement b) {
+    mpz_t ma, mb, mr; mpz_init(ma); mpz_init(mb); mpz_init(mr);
+    gmp_toMpz(ma, a); gmp_toMpz(mb, b);
+    mpz_mul(mr, ma, mb); mpz_mod(mr, mr, q);
+    gmp_fromMpz(r, mr);
+    mpz_clear(ma); mpz_clear(mb); mpz_clear(mr);
+}
+
+static void gmp_inv(PFrElement r, PFrElement a) {
+    mpz_t ma, mr; mpz_init(ma); mpz_init(mr);
+    gmp_toMpz(ma, a);
+    mpz_invert(mr, ma, q);
+    gmp_fromMpz(r, mr);
+    mpz_clear(ma); mpz_clear(mr);
+}
+
+typedef void (*BinOp)(PFrElement, PFrElement, PFrElement);
+typedef void (*UnOp)(PFrElement, PFrElement);
+
+static double benchUnOp(UnOp op, std::vector<FrElement> &v, long iters) {
+    size_t n = v.size();
+    FrElement acc;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) {
+        op(&acc, &v[i % n]);
+        v[i % n].longVal[0] ^= acc.longVal[0] & 1;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+}
+
+// 결과를 다음 입력으로 되먹여 연산 간 의존성을 유지한다 (컴파일러가 루프를 없애지 못하도록)
+static double benchBinOp(BinOp op, std::vector<FrElement> &v, long iters) {
+    size_t n = v.size();
+    FrElement acc = v[0];
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) {
+        op(&acc, &acc, &v[i % n]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    v[0] = acc;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+}
+
+typedef void (*BinOpN)(PFrElement, PFrElement, PFrElement, int);
+
+// 배열 커널과 원소별 호출 루프를 같은 입력으로 비교 (원소당 ns)
+static void benchArrayOp(const char *name, BinOpN vecOp, BinOp op, std::vector<FrElement> &a, std::vector<FrElement> &b, long iters) {
+    int n = (int)a.size();
+    std::vector<FrElement> r(n);
+    long rounds = iters / n + 1;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long k = 0; k < rounds; k++) vecOp(r.data(), a.data(), b.data(), n);
+    auto t1 = std::chrono::steady_clock::now();
+    for (long k = 0; k < rounds; k++) {
+        for (int i = 0; i < n; i++) op(&r[i], &a[i], &b[i]);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    double vecNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / (rounds * n);
+    double loopNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / (rounds * n);
+    printf("%-8s %-6s %8.1f ns/elem   loop %8.1f ns/elem   x%.2f\n", name, Fr_vecKernelName(), vecNs, loopNs, loopNs / vecNs);
+}
+
+// 지수 하나에 대한 Fr_pow 처리량 (ops/s)
+static void benchPow(const char *name, std::vector<FrElement> &v, FrElement &exponent, long iters) {
+    size_t n = v.size();
+    FrElement acc;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) {
+        Fr_pow(&acc, &v[i % n], &exponent);
+        v[i % n].longVal[0] ^= acc.longVal[0] & 1;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+    printf("pow %-12s %9.1f ns/op  %10.0f ops/s\n", name, ns, 1e9 / ns);
+}
+
+// a*b + c + d*k 형태의 식: 연산마다 reduce 하는 경로와 누산기(Fr_muladd / FrAccumulator)로 한 번만 reduce 하는 경로 비교
+static void benchFused(std::vector<FrElement> &v, long iters) {
+    size_t n = v.size();
+    FrElement acc = v[0], t1, t2;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) {
+        Fr_mul(&t1, &acc, &v[i % n]);
+        Fr_add(&acc, &t1, &v[(i + 1) % n]);
+    }
+    auto t1e = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) {
+        Fr_muladd(&acc, &acc, &v[i % n], &v[(i + 1) % n]);
+    }
+    auto t2e = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) {
+        Fr_mul(&t1, &acc, &v[i % n]);
+        Fr_add(&t2, &t1, &v[(i + 1) % n]);
+        Fr_mul(&t1, &v[(i + 2) % n], &v[(i + 3) % n]);
+        Fr_add(&acc, &t2, &t1);
+    }
+    auto t3e = std::chrono::steady_clock::now();
+    FrAccumulator fa;
+    for (long i = 0; i < iters; i++) {
+        Fr_accInit(&fa);
+        Fr_accMulAdd(&fa, &acc, &v[i % n]);
+        Fr_accAdd(&fa, &v[(i + 1) % n]);
+        Fr_accMulAdd(&fa, &v[(i + 2) % n], &v[(i + 3) % n]);
+        Fr_accFinish(&acc, &fa);
+    }
+    auto t4e = std::chrono::steady_clock::now();
+    v[0] = acc;
+    double sepNs = std::chrono::duration<double, std::nano>(t1e - t0).count() / iters;
+    double fusedNs = std::chrono::duration<double, std::nano>(t2e - t1e).count() / iters;
+    double sep4Ns = std::chrono::duration<double, std::nano>(t3e - t2e).count() / iters;
+    double accNs = std::chrono::duration<double, std::nano>(t4e - t3e).count() / iters;
+    printf("a*b+c       mul+add %8.1f ns   muladd %8.1f ns   x%.2f\n", sepNs, fusedNs, sepNs / fusedNs);
+    printf("a*b+c+d*k   4 ops   %8.1f ns   acc    %8.1f ns   x%.2f\n", sep4Ns, accNs, sep4Ns / accNs);
+}
+
+static void report(const char *name, double nativeNs, double gmpNs) {
+    printf("%-8s native %8.1f ns/op   gmp %8.1f ns/op   x%.1f\n", name, nativeNs, gmpNs, gmpNs / nativeNs);
+}
+
+// 10진 문자열 변환: Fr_str2element / Fr_element2str 와 기존 mpz 경로 비교 (원소당 ns)
+static void benchStr(std::vector<FrElement> &v, long iters) {
+    size_t n = v.size();
+    std::vector<std::string> strs(n);
+    Fr_element2strn(strs.data(), v.data(), (int)n, 10);
+    FrElement e;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) Fr_str2element(&e, strs[i % n].c_str(), 10);
+    auto t1 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) {
+        mpz_t m; mpz_init_set_str(m, strs[i % n].c_str(), 10);
+        gmp_fromMpz(&e, m);
+        mpz_clear(m);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) free(Fr_element2str(&v[i % n]));
+    auto t3 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) {
+        mpz_t m; mpz_init(m);
+        gmp_toMpz(m, &v[i % n]);
+        free(mpz_get_str(nullptr, 10, m));
+        mpz_clear(m);
+    }
+    auto t4 = std::chrono::steady_clock::now();
+    report("parse", std::chrono::duration<double, std::nano>(t1 - t0).count() / iters,
+           std::chrono::duration<double, std::nano>(t2 - t1).count() / iters);
+    report("tostr", std::chrono::duration<double, std::nano>(t3 - t2).count() / iters,
+           std::chrono::duration<double, std::nano>(t4 - t3).count() / iters);
+}
+
+
+int main(int argc, char **argv) {
+    long iters = argc > 1 ? atol(argv[1]) : 1000000;
+
+    mpz_init(q);
+    mpz_import(q, Fr_N64, -1, 8, -1, 0, (const void *)Fr_q.longVal);
+
+    // 일반 형식(Fr_LONG)과 Montgomery 형식(Fr_LONGMONTGOMERY) 입력을 각각 준비
+    std::mt19937_64 rng(42);
+    std::vector<FrElement> normal(1024), mont(1024);
+    for (size_t i = 0; i < normal.size(); i++) {
+        FrElement &e = normal[i];
+        e.shortVal = 0;
+        e.type = Fr_LONG;
+        for (int j = 0; j < Fr_N64; j++) e.longVal[j] = rng();
+        e.longVal[3] &= 0x0fffffffffffffffULL;
+        Fr_toMontgomery(&mont[i], &e);
+    }
+
+    printf("Fr benchmark: %ld iterations\n", iters);
+    report("add", benchBinOp(Fr_add, mont, iters), benchBinOp(gmp_add, normal, iters));
+    report("sub", benchBinOp(Fr_sub, mont, iters), benchBinOp(gmp_sub, normal, iters));
+    report("mul", benchBinOp(Fr_mul, mont, iters), benchBinOp(gmp_mul, normal, iters));
+    report("inv", benchUnOp(Fr_inv, mont, iters / 10), benchUnOp(gmp_inv, normal, iters / 10));
+    benchStr(normal, iters / 10);
+
+    benchFused(mont, iters);
+
+    FrElement e5 = {5, Fr_SHORT}, e65537 = {65537, Fr_SHORT}, eFermat, eRandom;
+    eFermat.shortVal = 0;
+    eFermat.type = Fr_LONG;
+    memcpy(eFermat.longVal, Fr_q.longVal, sizeof(eFermat.longVal));
+    eFermat.longVal[0] -= 2;
+    eRandom = normal[1];
+    benchPow("x^5", mont, e5, iters);
+    benchPow("x^65537", mont, e65537, iters / 10);
+    benchPow("x^(q-2)", mont, eFermat, iters / 100);
+    benchPow("x^random", mont, eRandom, iters / 100);
+
+    std::vector<FrElement> mont2(mont.rbegin(), mont.rend());
+    benchArrayOp("addn", Fr_addn, Fr_add, mont, mont2, iters);
+    benchArrayOp("subn", Fr_subn, Fr_sub, mont, mont2, iters);
+    benchArrayOp("muln", Fr_muln, Fr_mul, mont, mont2, iters);
+    benchArrayOp("eqn", Fr_eqn, Fr_eq, mont, mont2, iters);
+
+    mpz_clear(q);
+    return 0;
+}
@@ -0,0 +1,591 @@
+// Fr / Field 연산을 GMP mpz 모델과 대조하는 검사 (WITNESS_BUILD_TESTS=ON 일 때만 빌드, ctest 로 실행)
+// 경계값 (0, 1, q-1, (q±1)/2, int32 경계 ...) 과 무작위 값을 Fr_SHORT / Fr_LONG / Fr_LONGMONTGOMERY 형식으로 넣어
+// 결과 값과 오류 채널을 mpz 로 계산한 값과 비교한다. 누산기와 배열 커널은 스칼라 연산과 비교한다.
+// 사용법: fr-check [무작위 값 수]   (기기에서는 adb push 후 실행)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <string>
+#include <vector>
+#include <gmp.h>
+#include "fr.hpp"
+#include "field.hpp"
+
+static mpz_t q, halfQ, mask254, Rmod, Rinv;
+static int failures = 0;
+static long checks = 0;
+
+#define CHECK(cond, ...) do { \
+        checks++; \
+        if (!(cond)) { \
+            if (failures++ < 30) { printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } \
+        } \
+    } while (0)
+
+// ---- mpz <-> limb ----
+
+static void limbsToMpz(mpz_t r, const uint64_t *v, int n) {
+    mpz_import(r, n, -1, 8, -1, 0, (const void *)v);
+}
+
+static void mpzToLimbs(uint64_t *v, const mpz_t a, int n) {
+    memset(v, 0, n * 8);
+    size_t count;
+    mpz_export((void *)v, &count, -1, 8, -1, 0, a);
+}
+
+static std::string str(const mpz_t a) {
+    char *s = mpz_get_str(nullptr, 10, a);
+    std::string r(s);
+    free(s);
+    return r;
+}
+
+// 원소의 값 ([0, q)). fr.cpp 를 거치지 않고 형식 비트만 보고 해석한다
+static void decode(mpz_t r, const FrElement *e) {
+    if (e->type & Fr_LONG) {
+        limbsToMpz(r, e->longVal, Fr_N64);
+        if (e->type & Fr_SHORTMONTGOMERY) mpz_mul(r, r, Rinv);
+    } else {
+        mpz_set_si(r, e->shortVal);
+    }
+    mpz_mod(r, r, q);
+}
+
+enum { FORM_SHORT, FORM_LONG, FORM_MONT, FORM_COUNT };
+
+// v ([0, q)) 를 주어진 형식으로. int32 로 표현되지 않는 값의 FORM_SHORT 는 FORM_LONG 으로 만든다
+static void encode(FrElement *e, const mpz_t v, int form) {
+    mpz_t s; mpz_init(s);
+    mpz_set(s, v);
+    if (mpz_cmp(s, halfQ) > 0) mpz_sub(s, s, q);
+    e->shortVal = 0;
+    if (form == FORM_SHORT && mpz_cmp_si(s, INT32_MIN) >= 0 && mpz_cmp_si(s, INT32_MAX) <= 0) {
+        e->type = Fr_SHORT;
+        e->shortVal = (int32_t)mpz_get_si(s);
+        memset(e->longVal, 0, sizeof(e->longVal));
+    } else if (form == FORM_MONT) {
+        mpz_mul(s, v, Rmod);
+        mpz_mod(s, s, q);
+        e->type = Fr_LONGMONTGOMERY;
+        mpzToLimbs(e->longVal, s, Fr_N64);
+    } else {
+        e->type = Fr_LONG;
+        mpzToLimbs(e->longVal, v, Fr_N64);
+    }
+    mpz_clear(s);
+}
+
+// circom 의 부호 해석: (q-1)/2 보다 크면 음수
+static void toSigned(mpz_t r, const mpz_t a) {
+    mpz_set(r, a);
+    if (mpz_cmp(r, halfQ) > 0) mpz_sub(r, r, q);
+}
+
+// ---- 기준 모델 (circom 의미) ----
+
+typedef void (*RefOp)(mpz_t r, const mpz_t a, const mpz_t b, int &err);
+
+static void refAdd(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_add(r, a, b); mpz_mod(r, r, q); }
+static void refSub(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_sub(r, a, b); mpz_mod(r, r, q); }
+static void refMul(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_mul(r, a, b); mpz_mod(r, r, q); }
+
+static void refDiv(mpz_t r, const mpz_t a, const mpz_t b, int &err) {
+    if (!mpz_sgn(b)) { mpz_set_ui(r, 0); err = Fr_ERR_DIV_BY_ZERO; return; }
+    mpz_invert(r, b, q); mpz_mul(r, r, a); mpz_mod(r, r, q);
+}
+
+static void refIdiv(mpz_t r, const mpz_t a, const mpz_t b, int &err) {
+    if (!mpz_sgn(b)) { mpz_set_ui(r, 0); err = Fr_ERR_DIV_BY_ZERO; return; }
+    mpz_fdiv_q(r, a, b);
+}
+
+static void refMod(mpz_t r, const mpz_t a, const mpz_t b, int &err) {
+    if (!mpz_sgn(b)) { mpz_set_ui(r, 0); err = Fr_ERR_DIV_BY_ZERO; return; }
+    mpz_fdiv_r(r, a, b);
+}
+
+static void refPow(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_powm(r, a, b, q); }
+
+static int cmpSigned(const mpz_t a, const mpz_t b) {
+    mpz_t sa, sb; mpz_init(sa); mpz_init(sb);
+    toSigned(sa, a); toSigned(sb, b);
+    int c = mpz_cmp(sa, sb);
+    mpz_clear(sa); mpz_clear(sb);
+    return c;
+}
+
+static void refEq(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_set_ui(r, mpz_cmp(a, b) == 0); }
+static void refNeq(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_set_ui(r, mpz_cmp(a, b) != 0); }
+static void refLt(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_set_ui(r, cmpSigned(a, b) < 0); }
+static void refGt(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_set_ui(r, cmpSigned(a, b) > 0); }
+static void refLeq(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_set_ui(r, cmpSigned(a, b) <= 0); }
+static void refGeq(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_set_ui(r, cmpSigned(a, b) >= 0); }
+static void refLand(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_set_ui(r, mpz_sgn(a) && mpz_sgn(b)); }
+static void refLor(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_set_ui(r, mpz_sgn(a) || mpz_sgn(b)); }
+
+// 비트 연산 결과는 254 비트로 자르고 q 이상이면 q 를 뺀다
+static void reduceBits(mpz_t r) {
+    mpz_and(r, r, mask254);
+    if (mpz_cmp(r, q) >= 0) mpz_sub(r, r, q);
+}
+
+static void refBand(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_and(r, a, b); reduceBits(r); }
+static void refBor(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_ior(r, a, b); reduceBits(r); }
+static void refBxor(mpz_t r, const mpz_t a, const mpz_t b, int &) { mpz_xor(r, a, b); reduceBits(r); }
+
+// b 가 음수 ((q-1)/2 초과) 이면 반대 방향으로 q-b 만큼 민다. 254 이상이면 0
+static void refShr(mpz_t r, const mpz_t a, const mpz_t b, int &err);
+
+static void refShl(mpz_t r, const mpz_t a, const mpz_t b, int &err) {
+    if (mpz_cmp(b, halfQ) > 0) {
+        mpz_t nb; mpz_init(nb); mpz_sub(nb, q, b);
+        refShr(r, a, nb, err);
+        mpz_clear(nb);
+        return;
+    }
+    if (mpz_cmp_ui(b, 254) >= 0) { mpz_set_ui(r, 0); return; }
+    mpz_mul_2exp(r, a, mpz_get_ui(b));
+    reduceBits(r);
+}
+
+static void refShr(mpz_t r, const mpz_t a, const mpz_t b, int &err) {
+    if (mpz_cmp(b, halfQ) > 0) {
+        mpz_t nb; mpz_init(nb); mpz_sub(nb, q, b);
+        refShl(r, a, nb, err);
+        mpz_clear(nb);
+        return;
+    }
+    if (mpz_cmp_ui(b, 254) >= 0) { mpz_set_ui(r, 0); return; }
+    mpz_fdiv_q_2exp(r, a, mpz_get_ui(b));
+}
+
+typedef void (*FrBinOp)(PFrElement, PFrElement, PFrElement);
+
+struct BinCase {
+    const char *name;
+    FrBinOp op;
+    RefOp ref;
+};
+
+static const BinCase binOps[] = {
+        {"add", Fr_add, refAdd}, {"sub", Fr_sub, refSub}, {"mul", Fr_mul, refMul},
+        {"div", Fr_div, refDiv}, {"idiv", Fr_idiv, refIdiv}, {"mod", Fr_mod, refMod}, {"pow", Fr_pow, refPow},
+        {"eq", Fr_eq, refEq}, {"neq", Fr_neq, refNeq}, {"lt", Fr_lt, refLt}, {"gt", Fr_gt, refGt},
+        {"leq", Fr_leq, refLeq}, {"geq", Fr_geq, refGeq}, {"land", Fr_land, refLand}, {"lor", Fr_lor, refLor},
+        {"band", Fr_band, refBand}, {"bor", Fr_bor, refBor}, {"bxor", Fr_bxor, refBxor},
+        {"shl", Fr_shl, refShl}, {"shr", Fr_shr, refShr},
+};
+
+// ---- 입력 값 ----
+
+static std::vector<std::string> edgeValues() {
+    mpz_t t; mpz_init(t);
+    std::vector<std::string> v = {"0", "1", "2", "3", "253", "254", "255", "256",
+                                  "2147483647", "2147483648", "4294967295", "4294967296",
+                                  "18446744073709551615", "18446744073709551616"};
+    const unsigned long offsets[] = {1, 2, 2147483647, 2147483648UL, 2147483649UL};
+    for (unsigned long off : offsets) { mpz_sub_ui(t, q, off); v.push_back(str(t)); }  // q-1, q-2, int32 음수 경계
+    mpz_set(t, halfQ); v.push_back(str(t));                                    // (q-1)/2
+    mpz_add_ui(t, halfQ, 1); v.push_back(str(t));                              // (q+1)/2
+    mpz_sub_ui(t, halfQ, 1); v.push_back(str(t));
+    mpz_ui_pow_ui(t, 2, 253); v.push_back(str(t));
+    mpz_sub_ui(t, t, 1); v.push_back(str(t));
+    mpz_set(t, mask254); mpz_mod(t, t, q); v.push_back(str(t));
+    mpz_clear(t);
+    return v;
+}
+
+static void randomValue(mpz_t r, std::mt19937_64 &rng) {
+    uint64_t limbs[Fr_N64] = {rng(), rng(), rng(), rng()};
+    switch (rng() % 6) {
+        case 0: mpz_set_ui(r, rng() % 2147483648ULL); return;                           // 양의 int32
+        case 1: mpz_set_ui(r, 1 + rng() % 2147483648ULL); mpz_sub(r, q, r); return;      // 음의 int32
+        case 2: mpz_set_ui(r, rng() % 300); return;                                     // shift 양
+        case 3: limbsToMpz(r, limbs, 1 + rng() % 2); break;                             // 64~128 비트
+        default: limbsToMpz(r, limbs, Fr_N64); break;
+    }
+    mpz_mod(r, r, q);
+}
+
+// ---- 검사 ----
+
+static void checkBinary(const mpz_t a, const mpz_t b) {
+    mpz_t want, got; mpz_init(want); mpz_init(got);
+    FrElement ea, eb, er;
+    for (const BinCase &c : binOps) {
+        int wantErr = Fr_OK;
+        c.ref(want, a, b, wantErr);
+        for (int fa = 0; fa < FORM_COUNT; fa++) {
+            for (int fb = 0; fb < FORM_COUNT; fb++) {
+                encode(&ea, a, fa);
+                encode(&eb, b, fb);
+                Fr_clearError();
+                c.op(&er, &ea, &eb);
+                decode(got, &er);
+                CHECK(mpz_cmp(got, want) == 0 && Fr_getError() == wantErr,
+                      "%s(%s [%d], %s [%d]) = %s err %d, want %s err %d", c.name, str(a).c_str(), fa,
+                      str(b).c_str(), fb, str(got).c_str(), Fr_getError(), str(want).c_str(), wantErr);
+                // 결과가 첫 인자와 같은 원소여도 같아야 한다 (생성 코드가 흔히 쓴다)
+                Fr_clearError();
+                c.op(&ea, &ea, &eb);
+                decode(got, &ea);
+                CHECK(mpz_cmp(got, want) == 0, "%s aliased(%s [%d], %s [%d])", c.name, str(a).c_str(), fa,
+                      str(b).c_str(), fb);
+            }
+        }
+    }
+    Fr_clearError();
+    mpz_clear(want); mpz_clear(got);
+}
+
+static void checkUnary(const mpz_t a) {
+    mpz_t want, got, s; mpz_init(want); mpz_init(got); mpz_init(s);
+    FrElement ea, er;
+    toSigned(s, a);
+    bool fitsInt = mpz_cmp_si(s, INT32_MIN) >= 0 && mpz_cmp_si(s, INT32_MAX) <= 0;
+    for (int f = 0; f < FORM_COUNT; f++) {
+        std::string astr = str(a);
+        const char *as = astr.c_str();
+
+        encode(&ea, a, f);
+        Fr_neg(&er, &ea); decode(got, &er);
+        mpz_neg(want, a); mpz_mod(want, want, q);
+        CHECK(mpz_cmp(got, want) == 0, "neg(%s [%d])", as, f);
+
+        encode(&ea, a, f);
+        Fr_square(&er, &ea); decode(got, &er);
+        mpz_mul(want, a, a); mpz_mod(want, want, q);
+        CHECK(mpz_cmp(got, want) == 0, "square(%s [%d])", as, f);
+
+        encode(&ea, a, f);
+        Fr_clearError();
+        Fr_inv(&er, &ea); decode(got, &er);
+        if (mpz_sgn(a)) {
+            mpz_invert(want, a, q);
+            CHECK(mpz_cmp(got, want) == 0 && Fr_getError() == Fr_OK, "inv(%s [%d])", as, f);
+        } else {
+            CHECK(mpz_sgn(got) == 0 && Fr_getError() == Fr_ERR_DIV_BY_ZERO, "inv(0 [%d]) error", f);
+        }
+
+        encode(&ea, a, f);
+        Fr_bnot(&er, &ea); decode(got, &er);
+        mpz_com(want, a); reduceBits(want);
+        CHECK(mpz_cmp(got, want) == 0, "bnot(%s [%d])", as, f);
+
+        encode(&ea, a, f);
+        Fr_lnot(&er, &ea); decode(got, &er);
+        CHECK(mpz_cmp_ui(got, mpz_sgn(a) == 0) == 0, "lnot(%s [%d])", as, f);
+
+        encode(&ea, a, f);
+        CHECK(Fr_isTrue(&ea) == (mpz_sgn(a) != 0), "isTrue(%s [%d])", as, f);
+
+        encode(&ea, a, f);
+        Fr_clearError();
+        int ti = Fr_toInt(&ea);
+        if (fitsInt) {
+            CHECK(ti == mpz_get_si(s) && Fr_getError() == Fr_OK, "toInt(%s [%d]) = %d", as, f, ti);
+        } else {
+            CHECK(Fr_getError() == Fr_ERR_TOINT, "toInt(%s [%d]) should fail", as, f);
+        }
+        Fr_clearError();
+
+        // 형식 변환은 값을 바꾸지 않는다
+        encode(&ea, a, f);
+        Fr_toNormal(&er, &ea); decode(got, &er);
+        CHECK(mpz_cmp(got, a) == 0 && !(er.type & Fr_SHORTMONTGOMERY), "toNormal(%s [%d])", as, f);
+        Fr_toLongNormal(&er, &ea); decode(got, &er);
+        CHECK(mpz_cmp(got, a) == 0 && er.type == Fr_LONG, "toLongNormal(%s [%d])", as, f);
+        Fr_toMontgomery(&er, &ea); decode(got, &er);
+        CHECK(mpz_cmp(got, a) == 0 && (er.type & Fr_SHORTMONTGOMERY), "toMontgomery(%s [%d])", as, f);
+        Fr_copy(&er, &ea); decode(got, &er);
+        CHECK(mpz_cmp(got, a) == 0, "copy(%s [%d])", as, f);
+    }
+    mpz_clear(want); mpz_clear(got); mpz_clear(s);
+}
+
+// 진법 2/8/10/16 왕복과 mpz 문자열 비교
+static void checkStrings(const mpz_t a) {
+    static const uint bases[] = {2, 8, 10, 16};
+    mpz_t got; mpz_init(got);
+    FrRawElement raw, back;
+    mpzToLimbs(raw, a, Fr_N64);
+    for (uint base : bases) {
+        char buf[Fr_STR_MAX];
+        char *want = mpz_get_str(nullptr, base, a);
+        int n = Fr_raw2str(buf, sizeof(buf), raw, base);
+        CHECK(n == (int)strlen(want) && strcmp(buf, want) == 0, "raw2str(%s, %u) = %s", want, base, buf);
+        CHECK(Fr_str2raw(back, want, strlen(want), base) && memcmp(back, raw, sizeof(raw)) == 0,
+              "str2raw(%s, %u)", want, base);
+        free(want);
+    }
+    FrElement e;
+    for (int f = 0; f < FORM_COUNT; f++) {
+        encode(&e, a, f);
+        char *s = Fr_element2str(&e);
+        std::string want = str(a);
+        CHECK(want == s, "element2str(%s [%d]) = %s", want.c_str(), f, s);
+        free(s);
+    }
+    std::string dec = str(a);
+    CHECK(Fr_str2element(&e, dec.c_str(), 10), "str2element(%s)", dec.c_str());
+    decode(got, &e);
+    CHECK(mpz_cmp(got, a) == 0, "str2element(%s) value", dec.c_str());
+    mpz_clear(got);
+}
+
+// q 이상 / 2^256 이상의 긴 문자열은 mod q 로 줄인다. 잘못된 문자는 거부한다
+static void checkLongStrings(std::mt19937_64 &rng) {
+    mpz_t v, want, got; mpz_init(v); mpz_init(want); mpz_init(got);
+    FrRawElement raw;
+    FrElement e;
+    for (int i = 0; i < 200; i++) {
+        uint64_t limbs[8];
+        for (int j = 0; j < 8; j++) limbs[j] = rng();
+        limbsToMpz(v, limbs, 1 + i % 8);
+        mpz_mod(want, v, q);
+        for (uint base : {2u, 8u, 10u, 16u}) {
+            char *s = mpz_get_str(nullptr, base, v);
+            CHECK(Fr_str2raw(raw, s, strlen(s), base), "str2raw(%s, %u) rejected", s, base);
+            limbsToMpz(got, raw, Fr_N64);
+            CHECK(mpz_cmp(got, want) == 0, "str2raw(%s, %u) not reduced", s, base);
+            free(s);
+        }
+    }
+    CHECK(Fr_str2raw(raw, "ABCDEF", 6, 16), "upper case hex");
+    limbsToMpz(got, raw, Fr_N64);
+    CHECK(mpz_cmp_ui(got, 0xABCDEF) == 0, "upper case hex value");
+    CHECK(!Fr_str2raw(raw, "12a", 3, 10), "decimal with a letter");
+    CHECK(!Fr_str2raw(raw, "102", 3, 2), "binary digit 2");
+    CHECK(!Fr_str2raw(raw, "-1", 2, 10), "sign");
+    CHECK(!Fr_str2raw(raw, "", 0, 10), "empty");
+    CHECK(!Fr_str2raw(raw, "10", 2, 7), "base 7");
+    CHECK(!Fr_str2element(&e, "12x4", 10), "str2element invalid");
+
+    const char *strs[] = {"5", "bad", "21888242871839275222246405745257275088548364400416034343698204186575808495618"};
+    FrElement arr[3];
+    CHECK(Fr_str2elementn(arr, strs, 3, 10) == 1, "str2elementn invalid count");
+    decode(got, &arr[0]); CHECK(mpz_cmp_ui(got, 5) == 0, "str2elementn[0]");
+    decode(got, &arr[1]); CHECK(mpz_sgn(got) == 0, "str2elementn[1]");
+    decode(got, &arr[2]); CHECK(mpz_cmp_ui(got, 1) == 0, "str2elementn[2] (q + 1)");
+    std::string out[3];
+    Fr_element2strn(out, arr, 3, 16);
+    CHECK(out[0] == "5" && out[1] == "0" && out[2] == "1", "element2strn");
+    mpz_clear(v); mpz_clear(want); mpz_clear(got);
+}
+
+// 누산기 / 융합 연산은 같은 항을 Fr_mul / Fr_add / Fr_sub 로 계산한 값과 같아야 한다
+static void checkAccumulator(const std::vector<FrElement> &vals, std::mt19937_64 &rng) {
+    mpz_t want, got; mpz_init(want); mpz_init(got);
+    size_t n = vals.size();
+    for (int round = 0; round < 200; round++) {
+        int terms = round < 100 ? 1 + round % 8 : 1 + (int)(rng() % 2000);
+        FrAccumulator acc;
+        Fr_accInit(&acc);
+        FrElement sum = {0, Fr_SHORT}, t;
+        for (int k = 0; k < terms; k++) {
+            FrElement a = vals[rng() % n], b = vals[rng() % n];
+            switch (rng() % 3) {
+                case 0: Fr_accAdd(&acc, &a); Fr_add(&sum, &sum, &a); break;
+                case 1: Fr_accSub(&acc, &a); Fr_sub(&sum, &sum, &a); break;
+                default: Fr_accMulAdd(&acc, &a, &b); Fr_mul(&t, &a, &b); Fr_add(&sum, &sum, &t); break;
+            }
+        }
+        FrElement r;
+        Fr_accFinish(&r, &acc);
+        decode(got, &r);
+        decode(want, &sum);
+        CHECK(mpz_cmp(got, want) == 0, "accumulator with %d terms", terms);
+        CHECK(mpz_cmp(got, q) < 0 && (r.type & Fr_LONG), "accumulator result not canonical");
+    }
+    for (size_t i = 0; i < n; i++) {
+        FrElement a = vals[i], b = vals[(i + 1) % n], c = vals[(i + 7) % n], r, t, want2;
+        Fr_muladd(&r, &a, &b, &c);
+        Fr_mul(&t, &a, &b);
+        Fr_add(&want2, &t, &c);
+        decode(got, &r); decode(want, &want2);
+        CHECK(mpz_cmp(got, want) == 0, "muladd #%zu", i);
+        r = c;
+        Fr_mulacc(&r, &a, &b);
+        decode(got, &r);
+        CHECK(mpz_cmp(got, want) == 0, "mulacc #%zu", i);
+    }
+    mpz_clear(want); mpz_clear(got);
+}
+
+typedef void (*FrVecOp)(PFrElement, PFrElement, PFrElement, int);
+
+// 배열 커널 (SIMD 경로 포함) 은 원소별 스칼라 연산과 같아야 한다. 길이는 벡터 폭의 나머지가 생기도록 고른다
+static void checkVector(const std::vector<FrElement> &vals) {
+    struct { const char *name; FrVecOp vec; FrBinOp op; } ops[] = {
+            {"addn", Fr_addn, Fr_add}, {"subn", Fr_subn, Fr_sub}, {"muln", Fr_muln, Fr_mul}, {"eqn", Fr_eqn, Fr_eq}};
+    mpz_t want, got; mpz_init(want); mpz_init(got);
+    const int sizes[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 64, 127};
+    for (auto &o : ops) {
+        for (int n : sizes) {
+            if ((size_t)n > vals.size()) continue;
+            std::vector<FrElement> a(vals.begin(), vals.begin() + n);
+            std::vector<FrElement> b(vals.rbegin(), vals.rbegin() + n);
+            if (n > 2) b[n / 2] = a[n / 2];  // eqn 의 참 경우
+            std::vector<FrElement> r(n), inPlace(a);
+            o.vec(r.data(), a.data(), b.data(), n);
+            o.vec(inPlace.data(), inPlace.data(), b.data(), n);
+            for (int i = 0; i < n; i++) {
+                FrElement s;
+                o.op(&s, &a[i], &b[i]);
+                decode(want, &s);
+                decode(got, &r[i]);
+                CHECK(mpz_cmp(got, want) == 0, "%s[%d] of %d (%s)", o.name, i, n, Fr_vecKernelName());
+                decode(got, &inPlace[i]);
+                CHECK(mpz_cmp(got, want) == 0, "%s in place [%d] of %d", o.name, i, n);
+            }
+        }
+    }
+
+    // Fr_batchInv: 0 은 0 으로 두고 개수를 돌려준다. 청크 (256) 경계를 넘는 길이와 제자리 호출도 본다
+    for (int n : {40, 256, 600}) {
+        std::vector<FrElement> a(n), r(n);
+        for (int i = 0; i < n; i++) a[i] = vals[(i * 7) % vals.size()];
+        a[3] = FrElement{0, Fr_SHORT};
+        a[17].type = Fr_LONG;
+        memset(a[17].longVal, 0, sizeof(a[17].longVal));
+        int zeros = 0;
+        for (auto &e : a) { decode(got, &e); zeros += mpz_sgn(got) == 0; }
+        std::vector<FrElement> inPlace(a);
+        CHECK(Fr_batchInv(r.data(), a.data(), n) == zeros, "batchInv zero count (%d)", n);
+        CHECK(Fr_batchInv(inPlace.data(), inPlace.data(), n) == zeros, "batchInv in place zero count (%d)", n);
+        for (int i = 0; i < n; i++) {
+            decode(got, &a[i]);
+            if (mpz_sgn(got)) mpz_invert(want, got, q);
+            else mpz_set_ui(want, 0);
+            decode(got, &r[i]);
+            CHECK(mpz_cmp(got, want) == 0, "batchInv[%d] of %d", i, n);
+            decode(got, &inPlace[i]);
+            CHECK(mpz_cmp(got, want) == 0, "batchInv in place [%d] of %d", i, n);
+        }
+    }
+    mpz_clear(want); mpz_clear(got);
+}
+
+// Field<P> 인스턴스: 상수와 Montgomery 연산을 그 모듈러스의 mpz 계산과 비교
+template <typename P>
+static void checkField(const char *name, std::mt19937_64 &rng) {
+    typedef field::Field<P> F;
+    const int N = F::N;
+    mpz_t m, a, b, want, got, R, t; mpz_init(m); mpz_init(a); mpz_init(b); mpz_init(want); mpz_init(got);
+    mpz_init(R); mpz_init(t);
+    limbsToMpz(m, P::q.v, N);
+    mpz_set_ui(R, 1); mpz_mul_2exp(R, R, 64 * N); mpz_mod(R, R, m);
+
+    limbsToMpz(got, F::one.v, N);
+    CHECK(mpz_cmp(got, R) == 0, "%s one", name);
+    mpz_mul(want, R, R); mpz_mod(want, want, m);
+    limbsToMpz(got, F::R2.v, N);
+    CHECK(mpz_cmp(got, want) == 0, "%s R2", name);
+    mpz_mul(want, want, R); mpz_mod(want, want, m);
+    limbsToMpz(got, F::R3.v, N);
+    CHECK(mpz_cmp(got, want) == 0, "%s R3", name);
+    mpz_sub_ui(want, m, 1); mpz_fdiv_q_2exp(want, want, 1);
+    limbsToMpz(got, F::halfQ.v, N);
+    CHECK(mpz_cmp(got, want) == 0, "%s halfQ", name);
+    CHECK((uint64_t)(F::np * P::q.v[0]) == (uint64_t)-1, "%s np", name);
+
+    for (int i = 0; i < 2000; i++) {
+        uint64_t la[N], lb[N], ma[N], mb[N], r[N], e[N];
+        for (int j = 0; j < N; j++) { la[j] = rng(); lb[j] = rng(); e[j] = rng(); }
+        limbsToMpz(a, la, N); mpz_mod(a, a, m);
+        limbsToMpz(b, lb, N); mpz_mod(b, b, m);
+        if (i == 0) mpz_set_ui(a, 0);
+        if (i == 1) mpz_sub_ui(a, m, 1);
+        if (i == 2) mpz_set_ui(b, 1);
+        mpzToLimbs(la, a, N);
+        mpzToLimbs(lb, b, N);
+        F::toMontgomery(ma, la);
+        F::toMontgomery(mb, lb);
+        mpz_mul(want, a, R); mpz_mod(want, want, m);
+        limbsToMpz(got, ma, N);
+        CHECK(mpz_cmp(got, want) == 0, "%s toMontgomery", name);
+
+        F::add(r, ma, mb); F::fromMontgomery(r, r); limbsToMpz(got, r, N);
+        mpz_add(want, a, b); mpz_mod(want, want, m);
+        CHECK(mpz_cmp(got, want) == 0, "%s add", name);
+        F::sub(r, ma, mb); F::fromMontgomery(r, r); limbsToMpz(got, r, N);
+        mpz_sub(want, a, b); mpz_mod(want, want, m);
+        CHECK(mpz_cmp(got, want) == 0, "%s sub", name);
+        F::neg(r, ma); F::fromMontgomery(r, r); limbsToMpz(got, r, N);
+        mpz_neg(want, a); mpz_mod(want, want, m);
+        CHECK(mpz_cmp(got, want) == 0, "%s neg", name);
+        F::mul(r, ma, mb); F::fromMontgomery(r, r); limbsToMpz(got, r, N);
+        mpz_mul(want, a, b); mpz_mod(want, want, m);
+        CHECK(mpz_cmp(got, want) == 0, "%s mul", name);
+        F::square(r, ma); F::fromMontgomery(r, r); limbsToMpz(got, r, N);
+        mpz_mul(want, a, a); mpz_mod(want, want, m);
+        CHECK(mpz_cmp(got, want) == 0, "%s square", name);
+        if (i < 100) {
+            limbsToMpz(t, e, N);
+            F::pow(r, ma, e); F::fromMontgomery(r, r); limbsToMpz(got, r, N);
+            mpz_powm(want, a, t, m);
+            CHECK(mpz_cmp(got, want) == 0, "%s pow", name);
+            F::inv(r, ma); F::fromMontgomery(r, r); limbsToMpz(got, r, N);
+            if (mpz_sgn(a)) mpz_invert(want, a, m);
+            else mpz_set_ui(want, 0);
+            CHECK(mpz_cmp(got, want) == 0, "%s inv", name);
+        }
+        CHECK(F::eq(ma, ma) && (mpz_cmp(a, b) == 0) == F::eq(ma, mb), "%s eq", name);
+        CHECK(F::isZero(ma) == (mpz_sgn(a) == 0), "%s isZero", name);
+    }
+    mpz_clear(m); mpz_clear(a); mpz_clear(b); mpz_clear(want); mpz_clear(got); mpz_clear(R); mpz_clear(t);
+}
+
+int main(int argc, char **argv) {
+    int nRandom = argc > 1 ? atoi(argv[1]) : 60;
+
+    mpz_init(q); mpz_init(halfQ); mpz_init(mask254); mpz_init(Rmod); mpz_init(Rinv);
+    limbsToMpz(q, Fr_q.longVal, Fr_N64);
+    mpz_sub_ui(halfQ, q, 1); mpz_fdiv_q_2exp(halfQ, halfQ, 1);
+    mpz_set_ui(mask254, 1); mpz_mul_2exp(mask254, mask254, 254); mpz_sub_ui(mask254, mask254, 1);
+    mpz_set_ui(Rmod, 1); mpz_mul_2exp(Rmod, Rmod, 64 * Fr_N64); mpz_mod(Rmod, Rmod, q);
+    mpz_invert(Rinv, Rmod, q);
+
+    std::mt19937_64 rng(1);
+    std::vector<std::string> strs = edgeValues();
+    size_t nValues = strs.size() + nRandom;
+    mpz_t *values = new mpz_t[nValues];
+    for (size_t i = 0; i < nValues; i++) {
+        mpz_init(values[i]);
+        if (i < strs.size()) mpz_set_str(values[i], strs[i].c_str(), 10);
+        else randomValue(values[i], rng);
+    }
+    printf("fr-check: %zu values (%zu edge), vector kernel %s\n", nValues, strs.size(), Fr_vecKernelName());
+
+    for (size_t i = 0; i < nValues; i++) {
+        checkUnary(values[i]);
+        checkStrings(values[i]);
+        for (size_t j = 0; j < nValues; j++) checkBinary(values[i], values[j]);
+    }
+    checkLongStrings(rng);
+
+    // 누산기 / 배열 커널 입력: 모든 형식을 섞는다
+    std::vector<FrElement> elems;
+    for (int rep = 0; rep < 3; rep++) {
+        for (size_t i = 0; i < nValues; i++) {
+            FrElement e;
+            encode(&e, values[i], (int)((i + rep) % FORM_COUNT));
+            elems.push_back(e);
+        }
+    }
+    checkAccumulator(elems, rng);
+    checkVector(elems);
+
+    checkField<field::Bn254Fr>("Bn254Fr", rng);
+    checkField<field::Bn254Fq>("Bn254Fq", rng);
+    checkField<field::Bls12381Fr>("Bls12381Fr", rng);
+
+    for (size_t i = 0; i < nValues; i++) mpz_clear(values[i]);
+    delete[] values;
+    mpz_clear(q); mpz_clear(halfQ); mpz_clear(mask254); mpz_clear(Rmod); mpz_clear(Rinv);
+
+    printf("fr-check: %ld checks, %d failures\n", checks, failures);
+    return failures ? 1 : 0;
+}
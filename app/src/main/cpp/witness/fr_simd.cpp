@@ -0,0 +1,340 @@
+// 연속된 FrElement 배열에 대한 벡터 커널 (Fr_addn / Fr_subn / Fr_muln / Fr_eqn / Fr_copyn)
+//
+// - arm64: NEON, 2 원소씩 (레인 k 에 원소 i+k 의 limb j)
+// - x86_64: AVX2, 4 원소씩 (gather 로 limb 를 모은다)
+// - 그 외 / 기능 미지원 CPU: 스칼라 루프
+// 커널은 라이브러리 로드 시 CPU 기능을 검사해 한 번만 고른다.
+//
+// 벡터 경로는 블록 안의 피연산자가 모두 Fr_LONGMONTGOMERY 일 때만 쓰고, short 가 섞인
+// 블록은 Fr_add 등 스칼라 함수로 넘겨 short fast path 를 그대로 탄다.
+// NEON/AVX2 에는 64x64->128 곱셈이 없으므로 Fr_muln 은 어느 쪽이든 스칼라 Montgomery 루프다.
+// 지금은 생성 코드와 런타임 어디에서도 이 커널들을 부르지 않는다 (fr-check / fr-bench 만 쓴다).
+// arm64 에서 스칼라보다 빠른지는 측정하지 않았으니 쓰기 전에 fr-bench 로 재 본다.
+#include "fr.hpp"
+#include <string.h>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+typedef void (*FrBinOpN)(PFrElement r, PFrElement a, PFrElement b, int n);
+
+struct FrVecKernels {
+    const char *name;
+    FrBinOpN addn;
+    FrBinOpN subn;
+    FrBinOpN eqn;
+};
+
+static inline bool isLongMontgomery(PFrElement a) {
+    return a->type == Fr_LONGMONTGOMERY;
+}
+
+static inline bool blockIsLongMontgomery(PFrElement a, PFrElement b, int n) {
+    bool ok = true;
+    for (int k = 0; k < n; k++) {
+        ok &= isLongMontgomery(&a[k]) & isLongMontgomery(&b[k]);
+    }
+    return ok;
+}
+
+static inline void setLongMontgomeryType(PFrElement r, int n) {
+    for (int k = 0; k < n; k++) {
+        r[k].shortVal = 0;
+        r[k].type = Fr_LONGMONTGOMERY;
+    }
+}
+
+// -------------------------------------------------------------------------
+// 스칼라 커널
+// -------------------------------------------------------------------------
+
+static void addnScalar(PFrElement r, PFrElement a, PFrElement b, int n) {
+    for (int i = 0; i < n; i++) Fr_add(&r[i], &a[i], &b[i]);
+}
+
+static void subnScalar(PFrElement r, PFrElement a, PFrElement b, int n) {
+    for (int i = 0; i < n; i++) Fr_sub(&r[i], &a[i], &b[i]);
+}
+
+static void eqnScalar(PFrElement r, PFrElement a, PFrElement b, int n) {
+    for (int i = 0; i < n; i++) Fr_eq(&r[i], &a[i], &b[i]);
+}
+
+#if defined(__aarch64__)
+
+// -------------------------------------------------------------------------
+// NEON 커널. carry/borrow 는 레인별 0 또는 ~0 마스크로 들고 다닌다.
+// -------------------------------------------------------------------------
+
+static inline uint64x2_t neonLoadLimb(PFrElement a, int j) {
+    return vcombine_u64(vld1_u64(&a[0].longVal[j]), vld1_u64(&a[1].longVal[j]));
+}
+
+static inline void neonStoreLimb(PFrElement r, int j, uint64x2_t v) {
+    vst1_u64(&r[0].longVal[j], vget_low_u64(v));
+    vst1_u64(&r[1].longVal[j], vget_high_u64(v));
+}
+
+// x + y + carry
+static inline uint64x2_t neonAddLimb(uint64x2_t x, uint64x2_t y, uint64x2_t &carry) {
+    uint64x2_t s = vaddq_u64(x, y);
+    uint64x2_t c1 = vcltq_u64(s, x);
+    uint64x2_t s2 = vsubq_u64(s, carry);
+    uint64x2_t c2 = vandq_u64(vceqzq_u64(s2), carry);
+    carry = vorrq_u64(c1, c2);
+    return s2;
+}
+
+// x - y - borrow
+static inline uint64x2_t neonSubLimb(uint64x2_t x, uint64x2_t y, uint64x2_t &borrow) {
+    uint64x2_t d = vsubq_u64(x, y);
+    uint64x2_t b1 = vcltq_u64(x, y);
+    uint64x2_t b2 = vandq_u64(vceqzq_u64(d), borrow);
+    uint64x2_t d2 = vaddq_u64(d, borrow);
+    borrow = vorrq_u64(b1, b2);
+    return d2;
+}
+
+static void addnNeon(PFrElement r, PFrElement a, PFrElement b, int n) {
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        if (!blockIsLongMontgomery(&a[i], &b[i], 2)) {
+            addnScalar(&r[i], &a[i], &b[i], 2);
+            continue;
+        }
+        uint64x2_t s[Fr_N64], t[Fr_N64];
+        uint64x2_t carry = vdupq_n_u64(0);
+        for (int j = 0; j < Fr_N64; j++) {
+            s[j] = neonAddLimb(neonLoadLimb(&a[i], j), neonLoadLimb(&b[i], j), carry);
+        }
+        uint64x2_t borrow = vdupq_n_u64(0);
+        for (int j = 0; j < Fr_N64; j++) {
+            t[j] = neonSubLimb(s[j], vdupq_n_u64(Fr_q.longVal[j]), borrow);
+        }
+        // carry 가 났거나 s >= q 이면 s - q
+        uint64x2_t sel = vorrq_u64(carry, veorq_u64(borrow, vdupq_n_u64(~0ULL)));
+        setLongMontgomeryType(&r[i], 2);
+        for (int j = 0; j < Fr_N64; j++) {
+            neonStoreLimb(&r[i], j, vbslq_u64(sel, t[j], s[j]));
+        }
+    }
+    addnScalar(&r[i], &a[i], &b[i], n - i);
+}
+
+static void subnNeon(PFrElement r, PFrElement a, PFrElement b, int n) {
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        if (!blockIsLongMontgomery(&a[i], &b[i], 2)) {
+            subnScalar(&r[i], &a[i], &b[i], 2);
+            continue;
+        }
+        uint64x2_t d[Fr_N64];
+        uint64x2_t borrow = vdupq_n_u64(0);
+        for (int j = 0; j < Fr_N64; j++) {
+            d[j] = neonSubLimb(neonLoadLimb(&a[i], j), neonLoadLimb(&b[i], j), borrow);
+        }
+        // borrow 가 난 레인에만 q 를 더한다
+        uint64x2_t carry = vdupq_n_u64(0);
+        setLongMontgomeryType(&r[i], 2);
+        for (int j = 0; j < Fr_N64; j++) {
+            uint64x2_t qj = vandq_u64(vdupq_n_u64(Fr_q.longVal[j]), borrow);
+            neonStoreLimb(&r[i], j, neonAddLimb(d[j], qj, carry));
+        }
+    }
+    subnScalar(&r[i], &a[i], &b[i], n - i);
+}
+
+static void eqnNeon(PFrElement r, PFrElement a, PFrElement b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (!(isLongMontgomery(&a[i]) && isLongMontgomery(&b[i]))) {
+            Fr_eq(&r[i], &a[i], &b[i]);
+            continue;
+        }
+        uint64x2_t e0 = vceqq_u64(vld1q_u64(&a[i].longVal[0]), vld1q_u64(&b[i].longVal[0]));
+        uint64x2_t e1 = vceqq_u64(vld1q_u64(&a[i].longVal[2]), vld1q_u64(&b[i].longVal[2]));
+        uint64x2_t e = vandq_u64(e0, e1);
+        r[i].type = Fr_SHORT;
+        r[i].shortVal = (vgetq_lane_u64(e, 0) & vgetq_lane_u64(e, 1)) != 0;
+    }
+}
+
+static bool cpuHasNeon() {
+#if defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_ASIMD) != 0;
+#else
+    return true;
+#endif
+}
+
+#endif // __aarch64__
+
+#if defined(__x86_64__)
+
+// -------------------------------------------------------------------------
+// AVX2 커널. 부호 없는 비교는 부호 비트를 뒤집은 뒤 cmpgt_epi64 로 한다.
+// -------------------------------------------------------------------------
+
+#define FR_AVX2 __attribute__((target("avx2")))
+
+FR_AVX2 static inline __m256i avxLtU64(__m256i x, __m256i y) {
+    const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(y, sign), _mm256_xor_si256(x, sign));
+}
+
+FR_AVX2 static inline __m256i avxIsZero(__m256i x) {
+    return _mm256_cmpeq_epi64(x, _mm256_setzero_si256());
+}
+
+// FrElement 는 40바이트(= u64 5개) 간격이므로 gather 인덱스는 0,5,10,15
+FR_AVX2 static inline __m256i avxLoadLimb(PFrElement a, int j) {
+    const __m256i idx = _mm256_set_epi64x(15, 10, 5, 0);
+    return _mm256_i64gather_epi64((const long long *)&a[0].longVal[j], idx, 8);
+}
+
+FR_AVX2 static inline void avxStoreLimbs(PFrElement r, const __m256i v[Fr_N64]) {
+    alignas(32) uint64_t out[Fr_N64][4];
+    for (int j = 0; j < Fr_N64; j++) _mm256_store_si256((__m256i *)out[j], v[j]);
+    for (int k = 0; k < 4; k++) {
+        r[k].shortVal = 0;
+        r[k].type = Fr_LONGMONTGOMERY;
+        for (int j = 0; j < Fr_N64; j++) r[k].longVal[j] = out[j][k];
+    }
+}
+
+FR_AVX2 static inline __m256i avxAddLimb(__m256i x, __m256i y, __m256i &carry) {
+    __m256i s = _mm256_add_epi64(x, y);
+    __m256i c1 = avxLtU64(s, x);
+    __m256i s2 = _mm256_sub_epi64(s, carry);
+    __m256i c2 = _mm256_and_si256(avxIsZero(s2), carry);
+    carry = _mm256_or_si256(c1, c2);
+    return s2;
+}
+
+FR_AVX2 static inline __m256i avxSubLimb(__m256i x, __m256i y, __m256i &borrow) {
+    __m256i d = _mm256_sub_epi64(x, y);
+    __m256i b1 = avxLtU64(x, y);
+    __m256i b2 = _mm256_and_si256(avxIsZero(d), borrow);
+    __m256i d2 = _mm256_add_epi64(d, borrow);
+    borrow = _mm256_or_si256(b1, b2);
+    return d2;
+}
+
+FR_AVX2 static void addnAvx2(PFrElement r, PFrElement a, PFrElement b, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (!blockIsLongMontgomery(&a[i], &b[i], 4)) {
+            addnScalar(&r[i], &a[i], &b[i], 4);
+            continue;
+        }
+        __m256i s[Fr_N64], t[Fr_N64];
+        __m256i carry = _mm256_setzero_si256();
+        for (int j = 0; j < Fr_N64; j++) {
+            s[j] = avxAddLimb(avxLoadLimb(&a[i], j), avxLoadLimb(&b[i], j), carry);
+        }
+        __m256i borrow = _mm256_setzero_si256();
+        for (int j = 0; j < Fr_N64; j++) {
+            t[j] = avxSubLimb(s[j], _mm256_set1_epi64x((long long)Fr_q.longVal[j]), borrow);
+        }
+        // carry 가 났거나 s >= q 이면 s - q
+        __m256i sel = _mm256_or_si256(carry, _mm256_xor_si256(borrow, _mm256_set1_epi64x(-1)));
+        for (int j = 0; j < Fr_N64; j++) {
+            s[j] = _mm256_blendv_epi8(s[j], t[j], sel);
+        }
+        avxStoreLimbs(&r[i], s);
+    }
+    addnScalar(&r[i], &a[i], &b[i], n - i);
+}
+
+FR_AVX2 static void subnAvx2(PFrElement r, PFrElement a, PFrElement b, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (!blockIsLongMontgomery(&a[i], &b[i], 4)) {
+            subnScalar(&r[i], &a[i], &b[i], 4);
+            continue;
+        }
+        __m256i d[Fr_N64];
+        __m256i borrow = _mm256_setzero_si256();
+        for (int j = 0; j < Fr_N64; j++) {
+            d[j] = avxSubLimb(avxLoadLimb(&a[i], j), avxLoadLimb(&b[i], j), borrow);
+        }
+        // borrow 가 난 레인에만 q 를 더한다
+        __m256i carry = _mm256_setzero_si256();
+        for (int j = 0; j < Fr_N64; j++) {
+            __m256i qj = _mm256_and_si256(_mm256_set1_epi64x((long long)Fr_q.longVal[j]), borrow);
+            d[j] = avxAddLimb(d[j], qj, carry);
+        }
+        avxStoreLimbs(&r[i], d);
+    }
+    subnScalar(&r[i], &a[i], &b[i], n - i);
+}
+
+FR_AVX2 static void eqnAvx2(PFrElement r, PFrElement a, PFrElement b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (!(isLongMontgomery(&a[i]) && isLongMontgomery(&b[i]))) {
+            Fr_eq(&r[i], &a[i], &b[i]);
+            continue;
+        }
+        __m256i x = _mm256_loadu_si256((const __m256i *)a[i].longVal);
+        __m256i y = _mm256_loadu_si256((const __m256i *)b[i].longVal);
+        r[i].type = Fr_SHORT;
+        r[i].shortVal = _mm256_movemask_epi8(_mm256_cmpeq_epi64(x, y)) == -1;
+    }
+}
+
+#endif // __x86_64__
+
+static FrVecKernels selectKernels() {
+#if defined(__aarch64__)
+    if (cpuHasNeon()) return {"neon", addnNeon, subnNeon, eqnNeon};
+#elif defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return {"avx2", addnAvx2, subnAvx2, eqnAvx2};
+#endif
+    return {"scalar", addnScalar, subnScalar, eqnScalar};
+}
+
+static const FrVecKernels kernels = selectKernels();
+
+// -------------------------------------------------------------------------
+// 공개 API
+// -------------------------------------------------------------------------
+
+const char *Fr_vecKernelName() {
+    return kernels.name;
+}
+
+void Fr_copyn(PFrElement r, PFrElement a, int n) {
+    // libc memmove 가 이미 NEON/AVX2 로 구현되어 있으므로 그대로 사용
+    memmove(r, a, (size_t)n * sizeof(FrElement));
+}
+
+void Fr_addn(PFrElement r, PFrElement a, PFrElement b, int n) {
+    kernels.addn(r, a, b, n);
+}
+
+void Fr_subn(PFrElement r, PFrElement a, PFrElement b, int n) {
+    kernels.subn(r, a, b, n);
+}
+
+void Fr_eqn(PFrElement r, PFrElement a, PFrElement b, int n) {
+    kernels.eqn(r, a, b, n);
+}
+
+void Fr_muln(PFrElement r, PFrElement a, PFrElement b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (isLongMontgomery(&a[i]) && isLongMontgomery(&b[i])) {
+            r[i].shortVal = 0;
+            r[i].type = Fr_LONGMONTGOMERY;
+            Fr_rawMMul(r[i].longVal, a[i].longVal, b[i].longVal);
+        } else {
+            Fr_mul(&r[i], &a[i], &b[i]);
+        }
+    }
+}
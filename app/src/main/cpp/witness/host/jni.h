@@ -0,0 +1,30 @@
+#ifndef WITNESS_HOST_JNI_H
+#define WITNESS_HOST_JNI_H
+
+// 호스트 (안드로이드가 아닌) 빌드에서 native-witness.cpp 를 컴파일하기 위한 최소 jni.h.
+// 검사 / 벤치마크는 JNI 함수를 부르지 않으므로 타입과 native-witness.cpp 가 쓰는 메서드만 흉내 낸다.
+// 기기 빌드는 NDK 의 jni.h 를 쓴다 (CMakeLists.txt 가 ANDROID 가 아닐 때만 이 디렉터리를 include 한다).
+
+#include <stdint.h>
+
+#define JNIEXPORT __attribute__((visibility("default")))
+#define JNICALL
+
+typedef uint8_t jboolean;
+typedef int32_t jint;
+typedef int64_t jlong;
+
+class _jobject {};
+class _jstring : public _jobject {};
+typedef _jobject *jobject;
+typedef _jstring *jstring;
+
+struct JNIEnv {
+    const char *GetStringUTFChars(jstring s, jboolean *isCopy) {
+        if (isCopy) *isCopy = 0;
+        return reinterpret_cast<const char *>(s);
+    }
+    void ReleaseStringUTFChars(jstring, const char *) {}
+};
+
+#endif // WITNESS_HOST_JNI_H
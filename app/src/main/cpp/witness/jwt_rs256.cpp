@@ -3,9 +3,10 @@
 #include <assert.h>
 #include "circom.hpp"
 #include "calcwit.hpp"
-void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+#include "profiler.hpp"
+void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,const char *componentName,uint componentFather);
 void IsZero_0_run(uint ctx_index,Circom_CalcWit* ctx);
-void RSAMock_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void RSAMock_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,const char *componentName,uint componentFather);
 void RSAMock_1_run(uint ctx_index,Circom_CalcWit* ctx);
 Circom_TemplateFunction _functionTable[2] = { 
 IsZero_0_run,
@@ -31,18 +32,18 @@ uint get_size_of_io_map() {return 0;}
 
 uint get_size_of_bus_field_map() {return 0;}
 
-void release_memory_component(Circom_CalcWit* ctx, uint pos) {{
+// templateId 순서의 템플릿 이름 (assert 메시지용)
+static const char *templateNames[] = {"IsZero", "RSAMock"};
 
-if (pos != 0){{
+uint get_number_of_templates() {return 2;}
+
+const char *get_template_name(uint templateId) {return templateNames[templateId];}
 
-if(ctx->componentMemory[pos].subcomponents)
-delete []ctx->componentMemory[pos].subcomponents;
+void release_memory_component(Circom_CalcWit* ctx, uint pos) {{
 
-if(ctx->componentMemory[pos].subcomponentsParallel)
-delete []ctx->componentMemory[pos].subcomponentsParallel;
+if (pos != 0){{
 
-if(ctx->componentMemory[pos].outputIsSet)
-delete []ctx->componentMemory[pos].outputIsSet;
+// subcomponents / subcomponentsParallel / outputIsSet 은 componentArena 에서 할당되므로 reset() 에서 한 번에 해제
 
 if(ctx->componentMemory[pos].mutexes)
 delete []ctx->componentMemory[pos].mutexes;
@@ -61,24 +62,24 @@ delete []ctx->componentMemory[pos].sbct;
 
 // function declarations
 // template declarations
-void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,const char *componentName,uint componentFather){
 ctx->componentMemory[coffset].templateId = 0;
-ctx->componentMemory[coffset].templateName = "IsZero";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
 ctx->componentMemory[coffset].componentName = componentName;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->componentArena.alloc<uint>(0);
 }
 
 void IsZero_0_run(uint ctx_index,Circom_CalcWit* ctx){
+CIRCOM_PROF_TEMPLATE(0);
 FrElement* circuitConstants = ctx->circuitConstants;
-FrElement* signalValues = ctx->signalValues;
+FrElement sigaux[2];
 FrElement expaux[3];
 FrElement lvar[0];
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char *myTemplateName = get_template_name(ctx->componentMemory[ctx_index].templateId);
+const char *myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -87,36 +88,36 @@ std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
 uint sub_component_aux;
 uint index_multiple_eq;
 int cmp_index_ref_load = -1;
-Fr_neq(&expaux[0],&signalValues[mySignalStart + 1],&circuitConstants[0]); // line circom 41
+CIRCOM_PROF_LINE(41); Fr_neq(&expaux[0],ctx->loadSignal(mySignalStart + 1,&sigaux[0]),&circuitConstants[0]); // line circom 41
 if(Fr_isTrue(&expaux[0])){
 {
-PFrElement aux_dest = &signalValues[mySignalStart + 2];
+u64 aux_dest = mySignalStart + 2;
 // load src
-Fr_div(&expaux[0],&circuitConstants[1],&signalValues[mySignalStart + 1]); // line circom 41
+CIRCOM_PROF_LINE(41); Fr_div(&expaux[0],&circuitConstants[1],ctx->loadSignal(mySignalStart + 1,&sigaux[0])); // line circom 41
 // end load src
-Fr_copy(aux_dest,&expaux[0]);
+ctx->storeSignal(aux_dest,&expaux[0]);
 }
 }else{
 {
-PFrElement aux_dest = &signalValues[mySignalStart + 2];
+u64 aux_dest = mySignalStart + 2;
 // load src
 // end load src
-Fr_copy(aux_dest,&circuitConstants[0]);
+ctx->storeSignal(aux_dest,&circuitConstants[0]);
 }
 }
 {
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
+u64 aux_dest = mySignalStart + 0;
 // load src
-Fr_neg(&expaux[2],&signalValues[mySignalStart + 1]); // line circom 42
-Fr_mul(&expaux[1],&expaux[2],&signalValues[mySignalStart + 2]); // line circom 42
-Fr_add(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 42
+CIRCOM_PROF_LINE(42); Fr_neg(&expaux[2],ctx->loadSignal(mySignalStart + 1,&sigaux[0])); // line circom 42
+CIRCOM_PROF_LINE(42); Fr_mul(&expaux[1],&expaux[2],ctx->loadSignal(mySignalStart + 2,&sigaux[0])); // line circom 42
+CIRCOM_PROF_LINE(42); Fr_add(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 42
 // end load src
-Fr_copy(aux_dest,&expaux[0]);
+ctx->storeSignal(aux_dest,&expaux[0]);
 }
 {
-Fr_mul(&expaux[1],&signalValues[mySignalStart + 1],&signalValues[mySignalStart + 0]); // line circom 43
+CIRCOM_PROF_LINE(43); Fr_mul(&expaux[1],ctx->loadSignal(mySignalStart + 1,&sigaux[0]),ctx->loadSignal(mySignalStart + 0,&sigaux[1])); // line circom 43
 {{
-Fr_eq(&expaux[0],&expaux[1],&circuitConstants[0]); // line circom 43
+CIRCOM_PROF_LINE(43); Fr_eq(&expaux[0],&expaux[1],&circuitConstants[0]); // line circom 43
 }}
 if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 43. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
@@ -130,24 +131,24 @@ release_memory_component(ctx,index_subc);
 }
 }
 
-void RSAMock_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void RSAMock_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,const char *componentName,uint componentFather){
 ctx->componentMemory[coffset].templateId = 1;
-ctx->componentMemory[coffset].templateName = "RSAMock";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 97;
 ctx->componentMemory[coffset].componentName = componentName;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->componentArena.alloc<uint>(1);
 }
 
 void RSAMock_1_run(uint ctx_index,Circom_CalcWit* ctx){
+CIRCOM_PROF_TEMPLATE(1);
 FrElement* circuitConstants = ctx->circuitConstants;
-FrElement* signalValues = ctx->signalValues;
+FrElement sigaux[2];
 FrElement expaux[6];
 FrElement lvar[3];
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char *myTemplateName = get_template_name(ctx->componentMemory[ctx_index].templateId);
+const char *myComponentName = ctx->componentMemory[ctx_index].componentName;
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -169,16 +170,16 @@ PFrElement aux_dest = &lvar[1];
 Fr_copy(aux_dest,&circuitConstants[3]);
 }
 {
-std::string new_cmp_name = "checker";
+const char *new_cmp_name = "checker";
 IsZero_0_create(mySignalStart+20098,0+ctx_index+1,ctx,new_cmp_name,myId);
 mySubcomponents[0] = 0+ctx_index+1;
 }
 {
-PFrElement aux_dest = &signalValues[mySignalStart + 98];
+u64 aux_dest = mySignalStart + 98;
 // load src
-Fr_mul(&expaux[0],&signalValues[mySignalStart + 1],&signalValues[mySignalStart + 1]); // line circom 20
+CIRCOM_PROF_LINE(20); Fr_mul(&expaux[0],ctx->loadSignal(mySignalStart + 1,&sigaux[0]),ctx->loadSignal(mySignalStart + 1,&sigaux[1])); // line circom 20
 // end load src
-Fr_copy(aux_dest,&expaux[0]);
+ctx->storeSignal(aux_dest,&expaux[0]);
 }
 {
 PFrElement aux_dest = &lvar[2];
@@ -186,38 +187,38 @@ PFrElement aux_dest = &lvar[2];
 // end load src
 Fr_copy(aux_dest,&circuitConstants[1]);
 }
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 22
+CIRCOM_PROF_LINE(22); Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 22
 while(Fr_isTrue(&expaux[0])){
 {
-PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[2])) + 98)];
+u64 aux_dest = mySignalStart + ((1 * Fr_toInt(&lvar[2])) + 98);
 // load src
-Fr_sub(&expaux[3],&lvar[2],&circuitConstants[1]); // line circom 24
-Fr_sub(&expaux[4],&lvar[2],&circuitConstants[1]); // line circom 24
-Fr_mul(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 98)],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[4])) + 98)]); // line circom 24
-Fr_mod(&expaux[3],&lvar[2],&circuitConstants[2]); // line circom 24
-Fr_add(&expaux[1],&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 33)]); // line circom 24
-Fr_mod(&expaux[2],&lvar[2],&circuitConstants[2]); // line circom 24
-Fr_add(&expaux[0],&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[2])) + 65)]); // line circom 24
+CIRCOM_PROF_LINE(24); Fr_sub(&expaux[3],&lvar[2],&circuitConstants[1]); // line circom 24
+CIRCOM_PROF_LINE(24); Fr_sub(&expaux[4],&lvar[2],&circuitConstants[1]); // line circom 24
+CIRCOM_PROF_LINE(24); Fr_mul(&expaux[2],ctx->loadSignal(mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 98),&sigaux[0]),ctx->loadSignal(mySignalStart + ((1 * Fr_toInt(&expaux[4])) + 98),&sigaux[1])); // line circom 24
+CIRCOM_PROF_LINE(24); Fr_mod(&expaux[3],&lvar[2],&circuitConstants[2]); // line circom 24
+CIRCOM_PROF_LINE(24); Fr_add(&expaux[1],&expaux[2],ctx->loadSignal(mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 33),&sigaux[0])); // line circom 24
+CIRCOM_PROF_LINE(24); Fr_mod(&expaux[2],&lvar[2],&circuitConstants[2]); // line circom 24
+CIRCOM_PROF_LINE(24); Fr_add(&expaux[0],&expaux[1],ctx->loadSignal(mySignalStart + ((1 * Fr_toInt(&expaux[2])) + 65),&sigaux[0])); // line circom 24
 // end load src
-Fr_copy(aux_dest,&expaux[0]);
+ctx->storeSignal(aux_dest,&expaux[0]);
 }
 {
 PFrElement aux_dest = &lvar[2];
 // load src
-Fr_add(&expaux[0],&lvar[2],&circuitConstants[1]); // line circom 22
+CIRCOM_PROF_LINE(22); Fr_add(&expaux[0],&lvar[2],&circuitConstants[1]); // line circom 22
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 22
+CIRCOM_PROF_LINE(22); Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 22
 }
 {
 uint cmp_index_ref = 0;
 {
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
+u64 aux_dest = ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1;
 // load src
-Fr_sub(&expaux[0],&signalValues[mySignalStart + 20097],&signalValues[mySignalStart + 20097]); // line circom 29
+CIRCOM_PROF_LINE(29); Fr_sub(&expaux[0],ctx->loadSignal(mySignalStart + 20097,&sigaux[0]),ctx->loadSignal(mySignalStart + 20097,&sigaux[1])); // line circom 29
 // end load src
-Fr_copy(aux_dest,&expaux[0]);
+ctx->storeSignal(aux_dest,&expaux[0]);
 }
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
@@ -225,13 +226,13 @@ assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
 IsZero_0_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
+u64 aux_dest = mySignalStart + 0;
 // load src
 cmp_index_ref_load = 0;
 cmp_index_ref_load = 0;
-Fr_sub(&expaux[0],&circuitConstants[1],&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 0]); // line circom 31
+CIRCOM_PROF_LINE(31); Fr_sub(&expaux[0],&circuitConstants[1],ctx->loadSignal(ctx->componentMemory[mySubcomponents[0]].signalStart + 0,&sigaux[0])); // line circom 31
 // end load src
-Fr_copy(aux_dest,&expaux[0]);
+ctx->storeSignal(aux_dest,&expaux[0]);
 }
 for (uint i = 0; i < 1; i++){
 uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
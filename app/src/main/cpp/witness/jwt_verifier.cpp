@@ -3,9 +3,10 @@
 #include <assert.h>
 #include "circom.hpp"
 #include "calcwit.hpp"
-void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+#include "profiler.hpp"
+void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,const char *componentName,uint componentFather);
 void IsZero_0_run(uint ctx_index,Circom_CalcWit* ctx);
-void RealRSALike_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void RealRSALike_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,const char *componentName,uint componentFather);
 void RealRSALike_1_run(uint ctx_index,Circom_CalcWit* ctx);
 Circom_TemplateFunction _functionTable[2] = {
         IsZero_0_run,
@@ -31,18 +32,18 @@ uint get_size_of_io_map() {return 0;}
 
 uint get_size_of_bus_field_map() {return 0;}
 
-void release_memory_component(Circom_CalcWit* ctx, uint pos) {{
+// templateId 순서의 템플릿 이름 (assert 메시지용)
+static const char *templateNames[] = {"IsZero", "RealRSALike"};
 
-        if (pos != 0){{
+uint get_number_of_templates() {return 2;}
 
-                if(ctx->componentMemory[pos].subcomponents)
-                    delete []ctx->componentMemory[pos].subcomponents;
+const char *get_template_name(uint templateId) {return templateNames[templateId];}
+
+void release_memory_component(Circom_CalcWit* ctx, uint pos) {{
 
-                if(ctx->componentMemory[pos].subcomponentsParallel)
-                    delete []ctx->componentMemory[pos].subcomponentsParallel;
+        if (pos != 0){{
 
-                if(ctx->componentMemory[pos].outputIsSet)
-                    delete []ctx->componentMemory[pos].outputIsSet;
+                // subcomponents / subcomponentsParallel / outputIsSet 은 componentArena 에서 할당되므로 reset() 에서 한 번에 해제
 
                 if(ctx->componentMemory[pos].mutexes)
                     delete []ctx->componentMemory[pos].mutexes;
@@ -61,24 +62,24 @@ void release_memory_component(Circom_CalcWit* ctx, uint pos) {{
 
 // function declarations
 // template declarations
-void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void IsZero_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,const char *componentName,uint componentFather){
     ctx->componentMemory[coffset].templateId = 0;
-    ctx->componentMemory[coffset].templateName = "IsZero";
     ctx->componentMemory[coffset].signalStart = soffset;
     ctx->componentMemory[coffset].inputCounter = 1;
     ctx->componentMemory[coffset].componentName = componentName;
     ctx->componentMemory[coffset].idFather = componentFather;
-    ctx->componentMemory[coffset].subcomponents = new uint[0];
+    ctx->componentMemory[coffset].subcomponents = ctx->componentArena.alloc<uint>(0);
 }
 
 void IsZero_0_run(uint ctx_index,Circom_CalcWit* ctx){
+    CIRCOM_PROF_TEMPLATE(0);
     FrElement* circuitConstants = ctx->circuitConstants;
-    FrElement* signalValues = ctx->signalValues;
+    FrElement sigaux[2];
     FrElement expaux[3];
     FrElement lvar[0];
     u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-    std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-    std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+    const char *myTemplateName = get_template_name(ctx->componentMemory[ctx_index].templateId);
+    const char *myComponentName = ctx->componentMemory[ctx_index].componentName;
     u64 myFather = ctx->componentMemory[ctx_index].idFather;
     u64 myId = ctx_index;
     u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -87,36 +88,36 @@ void IsZero_0_run(uint ctx_index,Circom_CalcWit* ctx){
     uint sub_component_aux;
     uint index_multiple_eq;
     int cmp_index_ref_load = -1;
-    Fr_neq(&expaux[0],&signalValues[mySignalStart + 1],&circuitConstants[0]); // line circom 43
+    CIRCOM_PROF_LINE(43); Fr_neq(&expaux[0],ctx->loadSignal(mySignalStart + 1,&sigaux[0]),&circuitConstants[0]); // line circom 43
     if(Fr_isTrue(&expaux[0])){
         {
-            PFrElement aux_dest = &signalValues[mySignalStart + 2];
+            u64 aux_dest = mySignalStart + 2;
 // load src
-            Fr_div(&expaux[0],&circuitConstants[1],&signalValues[mySignalStart + 1]); // line circom 43
+            CIRCOM_PROF_LINE(43); Fr_div(&expaux[0],&circuitConstants[1],ctx->loadSignal(mySignalStart + 1,&sigaux[0])); // line circom 43
 // end load src
-            Fr_copy(aux_dest,&expaux[0]);
+            ctx->storeSignal(aux_dest,&expaux[0]);
         }
     }else{
         {
-            PFrElement aux_dest = &signalValues[mySignalStart + 2];
+            u64 aux_dest = mySignalStart + 2;
 // load src
 // end load src
-            Fr_copy(aux_dest,&circuitConstants[0]);
+            ctx->storeSignal(aux_dest,&circuitConstants[0]);
         }
     }
     {
-        PFrElement aux_dest = &signalValues[mySignalStart + 0];
+        u64 aux_dest = mySignalStart + 0;
 // load src
-        Fr_neg(&expaux[2],&signalValues[mySignalStart + 1]); // line circom 44
-        Fr_mul(&expaux[1],&expaux[2],&signalValues[mySignalStart + 2]); // line circom 44
-        Fr_add(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 44
+        CIRCOM_PROF_LINE(44); Fr_neg(&expaux[2],ctx->loadSignal(mySignalStart + 1,&sigaux[0])); // line circom 44
+        CIRCOM_PROF_LINE(44); Fr_mul(&expaux[1],&expaux[2],ctx->loadSignal(mySignalStart + 2,&sigaux[0])); // line circom 44
+        CIRCOM_PROF_LINE(44); Fr_add(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 44
 // end load src
-        Fr_copy(aux_dest,&expaux[0]);
+        ctx->storeSignal(aux_dest,&expaux[0]);
     }
     {
-        Fr_mul(&expaux[1],&signalValues[mySignalStart + 1],&signalValues[mySignalStart + 0]); // line circom 45
+        CIRCOM_PROF_LINE(45); Fr_mul(&expaux[1],ctx->loadSignal(mySignalStart + 1,&sigaux[0]),ctx->loadSignal(mySignalStart + 0,&sigaux[1])); // line circom 45
         {{
-                Fr_eq(&expaux[0],&expaux[1],&circuitConstants[0]); // line circom 45
+                CIRCOM_PROF_LINE(45); Fr_eq(&expaux[0],&expaux[1],&circuitConstants[0]); // line circom 45
             }}
         if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 45. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
         assert(Fr_isTrue(&expaux[0]));
@@ -130,24 +131,25 @@ void IsZero_0_run(uint ctx_index,Circom_CalcWit* ctx){
     }
 }
 
-void RealRSALike_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void RealRSALike_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,const char *componentName,uint componentFather){
     ctx->componentMemory[coffset].templateId = 1;
-    ctx->componentMemory[coffset].templateName = "RealRSALike";
     ctx->componentMemory[coffset].signalStart = soffset;
     ctx->componentMemory[coffset].inputCounter = 97;
     ctx->componentMemory[coffset].componentName = componentName;
     ctx->componentMemory[coffset].idFather = componentFather;
-    ctx->componentMemory[coffset].subcomponents = new uint[1]{0};
+    ctx->componentMemory[coffset].subcomponents = ctx->componentArena.alloc<uint>(1);
 }
 
 void RealRSALike_1_run(uint ctx_index,Circom_CalcWit* ctx){
+    CIRCOM_PROF_TEMPLATE(1);
     FrElement* circuitConstants = ctx->circuitConstants;
-    FrElement* signalValues = ctx->signalValues;
+    FrElement sigaux[2];
     FrElement expaux[6];
     FrElement lvar[3];
+    FrAccumulator expacc;
     u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-    std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-    std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+    const char *myTemplateName = get_template_name(ctx->componentMemory[ctx_index].templateId);
+    const char *myComponentName = ctx->componentMemory[ctx_index].componentName;
     u64 myFather = ctx->componentMemory[ctx_index].idFather;
     u64 myId = ctx_index;
     u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -169,16 +171,16 @@ void RealRSALike_1_run(uint ctx_index,Circom_CalcWit* ctx){
         Fr_copy(aux_dest,&circuitConstants[3]);
     }
     {
-        std::string new_cmp_name = "checker";
+        const char *new_cmp_name = "checker";
         IsZero_0_create(mySignalStart+150098,0+ctx_index+1,ctx,new_cmp_name,myId);
         mySubcomponents[0] = 0+ctx_index+1;
     }
     {
-        PFrElement aux_dest = &signalValues[mySignalStart + 98];
+        u64 aux_dest = mySignalStart + 98;
 // load src
-        Fr_mul(&expaux[0],&signalValues[mySignalStart + 1],&signalValues[mySignalStart + 1]); // line circom 21
+        CIRCOM_PROF_LINE(21); Fr_mul(&expaux[0],ctx->loadSignal(mySignalStart + 1,&sigaux[0]),ctx->loadSignal(mySignalStart + 1,&sigaux[1])); // line circom 21
 // end load src
-        Fr_copy(aux_dest,&expaux[0]);
+        ctx->storeSignal(aux_dest,&expaux[0]);
     }
     {
         PFrElement aux_dest = &lvar[2];
@@ -186,39 +188,41 @@ void RealRSALike_1_run(uint ctx_index,Circom_CalcWit* ctx){
 // end load src
         Fr_copy(aux_dest,&circuitConstants[1]);
     }
-    Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 24
+    CIRCOM_PROF_LINE(24); Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 24
     while(Fr_isTrue(&expaux[0])){
         {
-            PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[2])) + 98)];
+            u64 aux_dest = mySignalStart + ((1 * Fr_toInt(&lvar[2])) + 98);
 // load src
-            Fr_sub(&expaux[3],&lvar[2],&circuitConstants[1]); // line circom 27
-            Fr_sub(&expaux[4],&lvar[2],&circuitConstants[1]); // line circom 27
-            Fr_mul(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 98)],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[4])) + 98)]); // line circom 27
-            Fr_mod(&expaux[3],&lvar[2],&circuitConstants[2]); // line circom 27
-            Fr_add(&expaux[1],&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 33)]); // line circom 27
-            Fr_mod(&expaux[3],&lvar[2],&circuitConstants[2]); // line circom 27
-            Fr_mul(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 65)],&circuitConstants[0]); // line circom 27
-            Fr_add(&expaux[0],&expaux[1],&expaux[2]); // line circom 27
+            CIRCOM_PROF_LINE(27); Fr_sub(&expaux[3],&lvar[2],&circuitConstants[1]); // line circom 27
+            CIRCOM_PROF_LINE(27); Fr_sub(&expaux[4],&lvar[2],&circuitConstants[1]); // line circom 27
+            // a*b + c + d*k 를 누산기로 합쳐 reduction 을 한 번만 한다
+            Fr_accInit(&expacc);
+            CIRCOM_PROF_LINE(27); Fr_accMulAdd(&expacc,ctx->loadSignal(mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 98),&sigaux[0]),ctx->loadSignal(mySignalStart + ((1 * Fr_toInt(&expaux[4])) + 98),&sigaux[1])); // line circom 27
+            CIRCOM_PROF_LINE(27); Fr_mod(&expaux[3],&lvar[2],&circuitConstants[2]); // line circom 27
+            CIRCOM_PROF_LINE(27); Fr_accAdd(&expacc,ctx->loadSignal(mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 33),&sigaux[0])); // line circom 27
+            CIRCOM_PROF_LINE(27); Fr_mod(&expaux[3],&lvar[2],&circuitConstants[2]); // line circom 27
+            CIRCOM_PROF_LINE(27); Fr_accMulAdd(&expacc,ctx->loadSignal(mySignalStart + ((1 * Fr_toInt(&expaux[3])) + 65),&sigaux[0]),&circuitConstants[0]); // line circom 27
+            CIRCOM_PROF_LINE(27); Fr_accFinish(&expaux[0],&expacc); // line circom 27
 // end load src
-            Fr_copy(aux_dest,&expaux[0]);
+            ctx->storeSignal(aux_dest,&expaux[0]);
         }
         {
             PFrElement aux_dest = &lvar[2];
 // load src
-            Fr_add(&expaux[0],&lvar[2],&circuitConstants[1]); // line circom 24
+            CIRCOM_PROF_LINE(24); Fr_add(&expaux[0],&lvar[2],&circuitConstants[1]); // line circom 24
 // end load src
             Fr_copy(aux_dest,&expaux[0]);
         }
-        Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 24
+        CIRCOM_PROF_LINE(24); Fr_lt(&expaux[0],&lvar[2],&circuitConstants[4]); // line circom 24
     }
     {
         uint cmp_index_ref = 0;
         {
-            PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
+            u64 aux_dest = ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1;
 // load src
-            Fr_sub(&expaux[0],&signalValues[mySignalStart + 150097],&signalValues[mySignalStart + 150097]); // line circom 34
+            CIRCOM_PROF_LINE(34); Fr_sub(&expaux[0],ctx->loadSignal(mySignalStart + 150097,&sigaux[0]),ctx->loadSignal(mySignalStart + 150097,&sigaux[1])); // line circom 34
 // end load src
-            Fr_copy(aux_dest,&expaux[0]);
+            ctx->storeSignal(aux_dest,&expaux[0]);
         }
 // need to run sub component
         ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
@@ -226,13 +230,13 @@ void RealRSALike_1_run(uint ctx_index,Circom_CalcWit* ctx){
         IsZero_0_run(mySubcomponents[cmp_index_ref],ctx);
     }
     {
-        PFrElement aux_dest = &signalValues[mySignalStart + 0];
+        u64 aux_dest = mySignalStart + 0;
 // load src
         cmp_index_ref_load = 0;
         cmp_index_ref_load = 0;
-        Fr_sub(&expaux[0],&circuitConstants[1],&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 0]); // line circom 36
+        CIRCOM_PROF_LINE(36); Fr_sub(&expaux[0],&circuitConstants[1],ctx->loadSignal(ctx->componentMemory[mySubcomponents[0]].signalStart + 0,&sigaux[0])); // line circom 36
 // end load src
-        Fr_copy(aux_dest,&expaux[0]);
+        ctx->storeSignal(aux_dest,&expaux[0]);
     }
     for (uint i = 0; i < 1; i++){
         uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
@@ -0,0 +1,94 @@
+#ifndef CIRCOM_MAPPEDFILE_HPP
+#define CIRCOM_MAPPEDFILE_HPP
+
+// 읽기 전용 파일 매핑 (RAII). 소멸하거나 release() 하면 munmap 한다.
+// circuit.dat 을 복사하지 않고 Circom_Circuit 이 매핑 안을 직접 가리키게 할 때 쓴다.
+// 파일 전체 대신 열린 fd 의 [offset, offset + length) 만 매핑할 수도 있다 (APK 안의 압축 안 된 asset 은
+// AssetFileDescriptor 의 fd / startOffset / length 로 바로 읽힌다). data() 는 항상 구간의 시작이다.
+// 매핑은 PROT_READ 이므로 가리키는 배열에 쓰면 SIGSEGV 가 난다 (생성 코드와 Fr 연산은 상수를 읽기만 한다).
+// 페이지는 파일 캐시와 공유되어 프로세스의 익명 메모리 (RSS 의 private dirty) 로 잡히지 않는다.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+class Circom_MappedFile {
+public:
+    Circom_MappedFile() : base(NULL), length(0), mapBase(NULL), mapLength(0) {}
+    ~Circom_MappedFile() { release(); }
+
+    Circom_MappedFile(const Circom_MappedFile &) = delete;
+    Circom_MappedFile &operator=(const Circom_MappedFile &) = delete;
+
+    // 파일 전체를 매핑한다. 실패하면 false (errno 유지)
+    bool open(const char *path) {
+        release();
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd == -1) return false;
+        bool ok = open(fd, 0, 0);
+        ::close(fd);
+        return ok;
+    }
+
+    // fd 의 [offset, offset + len) 을 매핑한다 (len == 0 이면 파일 끝까지). fd 는 닫지 않으며 바로 닫아도 된다.
+    // offset 은 페이지 경계가 아니어도 된다 (앞쪽을 페이지 경계까지 넓혀 매핑한다)
+    bool open(int fd, uint64_t offset, uint64_t len) {
+        release();
+        struct stat sb;
+        if (fstat(fd, &sb) == -1 || (uint64_t)sb.st_size <= offset) return false;
+        if (len == 0) len = (uint64_t)sb.st_size - offset;
+        if (len > (uint64_t)sb.st_size - offset) return false;
+        uint64_t page = (uint64_t)sysconf(_SC_PAGESIZE);
+        uint64_t start = offset & ~(page - 1);
+        size_t mapLen = (size_t)(len + (offset - start));
+        void *p = mmap(NULL, mapLen, PROT_READ, MAP_PRIVATE, fd, (off_t)start);
+        if (p == MAP_FAILED) return false;
+        mapBase = (uint8_t *)p;
+        mapLength = mapLen;
+        base = mapBase + (offset - start);
+        length = (size_t)len;
+        return true;
+    }
+
+    void release() {
+        if (mapBase) munmap(mapBase, mapLength);
+        mapBase = NULL;
+        mapLength = 0;
+        base = NULL;
+        length = 0;
+    }
+
+    // [offset, offset + len) 구간에 madvise. 시작은 페이지 경계로 내린다. 힌트일 뿐이라 실패는 무시한다
+    void advise(size_t offset, size_t len, int advice) const {
+        if (!base || len == 0 || offset >= length) return;
+        if (len > length - offset) len = length - offset;
+        // 주소 기준으로 페이지 경계까지 내린다 (구간 시작이 페이지 경계가 아닐 수 있다)
+        uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+        uintptr_t addr = (uintptr_t)(base + offset);
+        uintptr_t start = addr & ~(page - 1);
+        madvise((void *)start, len + (addr - start), advice);
+    }
+
+    // 구간이 파일 안에 있고 T 에 맞게 정렬되어 있으면 그 위치, 아니면 NULL
+    template <typename T>
+    T *at(size_t offset, size_t count) const {
+        if (!base || offset > length || count > (length - offset) / sizeof(T)) return NULL;
+        if ((((uintptr_t)base + offset) & (alignof(T) - 1)) != 0) return NULL;
+        return (T *)(base + offset);
+    }
+
+    bool isOpen() const { return base != NULL; }
+    const uint8_t *data() const { return base; }
+    size_t size() const { return length; }
+
+private:
+    const uint8_t *base;    // 요청한 구간
+    size_t length;
+    uint8_t *mapBase;       // 실제 매핑 (페이지 경계)
+    size_t mapLength;
+};
+
+#endif // CIRCOM_MAPPEDFILE_HPP
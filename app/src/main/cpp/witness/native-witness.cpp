@@ -1,144 +1,361 @@
 #include <jni.h>
 #include <string>
 #include <vector>
+#include <mutex>
+#include <thread>
 #include <iostream>
 #include <fstream>
-#include <sstream>
-#include <iomanip>
 #include <sys/stat.h>
-#include <sys/mman.h>
-#include <fcntl.h>
-#include <unistd.h>
-#include <android/log.h>
+#include "../native_log.hpp"
 #include "../nlohmann/json.hpp"
 #include "calcwit.hpp"
 #include "circom.hpp"
+#include "profiler.hpp"
 
 using json = nlohmann::json;
 
 #define TAG "NativeWitness"
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, TAG, __VA_ARGS__)
+#define LOGD(...) NATIVE_LOGD(TAG, __VA_ARGS__)
+#define LOGI(...) NATIVE_LOGI(TAG, __VA_ARGS__)
+#define LOGE(...) NATIVE_LOGE(TAG, __VA_ARGS__)
 
 // -------------------------------------------------------------------------
 // Helper Functions
 // -------------------------------------------------------------------------
 
-Circom_Circuit* loadCircuit(std::string const &datFileName) {
+// loadCircuit 가 만든 것을 해제한다. zero-copy 로드면 배열은 매핑 소유라 munmap 만 한다
+void freeCircuit(Circom_Circuit *circuit) {
+    if (!circuit) return;
+    Circom_freeInputIndex(circuit);
+    if (!circuit->dataMapped) {
+        delete [] circuit->InputHashMap;
+        delete [] circuit->circuitConstants;
+    }
+    circuit->datFile.release();
+    delete circuit;
+}
+
+// 구간 checksum 을 검사한다 (구간마다 처음 한 번만 계산). 틀리면 false
+static bool verifyDatSection(Circom_Circuit *circuit, int type, const char *name) {
+    if (circuit->dat.verify(type)) return true;
+    LOGE("❌ CRITICAL: .dat %s checksum mismatch", name);
+    return false;
+}
+
+template <typename T>
+static bool isAligned(const u8 *p) {
+    return ((uintptr_t)p & (alignof(T) - 1)) == 0;
+}
+
+// witness 표를 circuit->witnessRuns 로 읽는다. run 구간이 없으면 u64 목록을 run 으로 바꾼다
+static bool loadWitnessRuns(Circom_Circuit *circuit) {
+    size_t len;
+    const u8 *runs = circuit->dat.locate(Circom_DAT_WITNESS_RUNS, len);
+    if (runs) {
+        if (!verifyDatSection(circuit, Circom_DAT_WITNESS_RUNS, "WitnessRuns")) return false;
+        circuit->witnessRuns.resize(len / sizeof(Circom_WitnessRun));
+        memcpy((void *)circuit->witnessRuns.data(), runs, len);
+    } else {
+        const u8 *list = circuit->dat.locate(Circom_DAT_WITNESS_MAP, len);
+        if (!verifyDatSection(circuit, Circom_DAT_WITNESS_MAP, "WitnessMap")) return false;
+        std::vector<u64> aligned;
+        if (!isAligned<u64>(list)) {
+            aligned.resize(len / sizeof(u64));
+            memcpy((void *)aligned.data(), list, len);
+            list = (const u8 *)aligned.data();
+        }
+        Circom_encodeWitnessRuns((const uint64_t *)list, len / sizeof(u64), circuit->witnessRuns);
+        // 목록은 다시 읽지 않는다. 매핑의 깨끗한 파일 페이지라 버려도 된다
+        if (aligned.empty()) circuit->datFile.advise(list - circuit->datFile.data(), len, MADV_DONTNEED);
+    }
+    std::string error;
+    if (!Circom_checkWitnessRuns(circuit->witnessRuns.data(), circuit->witnessRuns.size(), error)) {
+        LOGE("❌ CRITICAL: invalid .dat witness table: %s", error.c_str());
+        return false;
+    }
+    return true;
+}
+
+// circuit->datFile 에 매핑된 .dat 으로 Circom_Circuit 을 채운다 (loadCircuit / loadCircuitFd 공용). 실패하면 false
+// 컨테이너 (datfile.hpp) 와 헤더 없는 raw .dat 을 모두 받는다.
+// zeroCopy 면 InputHashMap / circuitConstants 가 읽기 전용 매핑을 직접 가리키고,
+// 아니면 (또는 구간이 정렬되어 있지 않으면) 힙으로 복사한 뒤 매핑을 바로 닫는다 (circuit->dat 도 비운다).
+// witness 표는 항상 run 배열로 갖고 있는다. version 2 컨테이너는 run 구간을 그대로 읽고,
+// raw / version 1 의 u64 목록은 로드 때 한 번 읽어 run 으로 바꾼 뒤 그 페이지를 버린다.
+static bool loadMappedCircuit(Circom_Circuit *circuit, bool zeroCopy) {
+    Circom_MappedFile &file = circuit->datFile;
+    LOGD("📂 mmap success. Address: %p, Size: %zu bytes", file.data(), file.size());
+
+    // 🔥 여기서 죽으면 .dat 이 이 회로용이 아니거나 잘린 것 (헤더 / 회로 해시 / 구간 범위와 길이 검사)
+    std::string error;
+    if (!circuit->dat.open(file.data(), file.size(), error)) {
+        LOGE("❌ CRITICAL: invalid .dat file: %s", error.c_str());
+        return false;
+    }
+
+    size_t nInputs = get_size_of_input_hashmap();
+    size_t nWitness = get_size_of_witness();
+    size_t nConstants = get_size_of_constants();
+    size_t inputLen, constantsLen;
+    const u8 *inputs = circuit->dat.locate(Circom_DAT_INPUT_HASHMAP, inputLen);
+    const u8 *constants = circuit->dat.locate(Circom_DAT_CONSTANTS, constantsLen);
+
+    // 읽는 구간은 모두 지금 검사한다. 복사 로드는 아래에서 매핑을 닫으므로 나중에 검사할 수 없다
+    bool mapped = zeroCopy && isAligned<FrElement>(constants);
+    bool container = circuit->dat.isContainer();
+    if (!verifyDatSection(circuit, Circom_DAT_INPUT_HASHMAP, "InputHashMap") ||
+        !verifyDatSection(circuit, Circom_DAT_CONSTANTS, "constants") ||
+        !loadWitnessRuns(circuit)) {
+        return false;
+    }
+
+    if (mapped) {
+        circuit->InputHashMap = (HashSignalInfo *)inputs;
+        circuit->circuitConstants = (FrElement *)constants;
+        circuit->dataMapped = true;
+        // 입력 표와 상수는 곧바로 읽힌다
+        file.advise(inputs - file.data(), inputLen, MADV_WILLNEED);
+        file.advise(constants - file.data(), constantsLen, MADV_WILLNEED);
+    } else {
+        if (zeroCopy) LOGD("📂 .dat sections are not aligned, copying");
+        circuit->InputHashMap = new HashSignalInfo[nInputs];
+        memcpy((void *)circuit->InputHashMap, inputs, inputLen);
+        circuit->circuitConstants = new FrElement[nConstants];
+        memcpy((void *)circuit->circuitConstants, constants, constantsLen);
+        circuit->dat.close();
+        file.release();
+    }
+    Circom_buildInputIndex(circuit);
+    LOGD("✅ %s sections %s. %zu witness in %zu runs, %zu constants, %u inputs indexed",
+         container ? "Container" : "Raw", circuit->dataMapped ? "mapped" : "copied",
+         nWitness, circuit->witnessRuns.size(), nConstants, circuit->inputIndexSize);
+
+    // 4. IO Map (보통 없으므로 패스하거나 간단 처리)
+    std::map<u32,IOFieldDefPair> templateInsId2IOSignalInfo1;
+    if (get_size_of_io_map()>0) {
+        // ... (생략, 보통 0임) ...
+    }
+    circuit->templateInsId2IOSignalInfo = move(templateInsId2IOSignalInfo1);
+
+    LOGI("✅ loadCircuit Finish Successfully.");
+    return true;
+}
+
+// circuit.dat 파일을 mmap 해서 Circom_Circuit 을 만든다. 실패하면 nullptr (만들던 것은 모두 해제)
+Circom_Circuit* loadCircuit(std::string const &datFileName, bool zeroCopy = true) {
     LOGD("📂 loadCircuit Start: %s", datFileName.c_str());
     Circom_Circuit *circuit = new Circom_Circuit;
-    int fd;
-    struct stat sb;
-
-    fd = open(datFileName.c_str(), O_RDONLY);
-    if (fd == -1) {
-        LOGE("❌ Error: .dat file not found: %s", datFileName.c_str());
+    if (!circuit->datFile.open(datFileName.c_str())) {
+        LOGE("❌ Error: cannot map .dat file: %s", datFileName.c_str());
+        freeCircuit(circuit);
         return nullptr;
     }
-
-    if (fstat(fd, &sb) == -1) {
-        LOGE("❌ Error: fstat failed");
-        close(fd);
+    if (!loadMappedCircuit(circuit, zeroCopy)) {
+        freeCircuit(circuit);
         return nullptr;
     }
-    LOGD("📂 File Size: %ld bytes", sb.st_size);
-
-    u8* bdata = (u8*)mmap(NULL, sb.st_size, PROT_READ , MAP_PRIVATE, fd, 0);
-    close(fd);
+    return circuit;
+}
 
-    if (bdata == MAP_FAILED) {
-        LOGE("❌ Error: mmap failed");
+// 열린 fd 의 [offset, offset + length) 구간을 .dat 으로 매핑한다 (length 0 = 파일 끝까지).
+// APK 에 압축 없이 들어 있는 asset 을 캐시로 복사하지 않고 AssetFileDescriptor 로 바로 읽을 때 쓴다.
+// fd 는 빌리기만 하고 닫지 않는다 (매핑은 fd 를 닫은 뒤에도 남는다)
+Circom_Circuit* loadCircuitFd(int fd, uint64_t offset, uint64_t length, bool zeroCopy = true) {
+    LOGD("📂 loadCircuit Start: fd %d [%llu +%llu]", fd, (unsigned long long)offset, (unsigned long long)length);
+    Circom_Circuit *circuit = new Circom_Circuit;
+    if (!circuit->datFile.open(fd, offset, length)) {
+        LOGE("❌ Error: cannot map .dat range: fd %d [%llu +%llu]", fd,
+             (unsigned long long)offset, (unsigned long long)length);
+        freeCircuit(circuit);
+        return nullptr;
+    }
+    if (!loadMappedCircuit(circuit, zeroCopy)) {
+        freeCircuit(circuit);
         return nullptr;
     }
-    LOGD("📂 mmap success. Address: %p", bdata);
+    return circuit;
+}
 
-    // 1. InputHashMap 로딩
-    LOGD("📂 Loading InputHashMap... Size: %u", get_size_of_input_hashmap());
-    circuit->InputHashMap = new HashSignalInfo[get_size_of_input_hashmap()];
-    uint dsize = get_size_of_input_hashmap()*sizeof(HashSignalInfo);
+// 프로세스 전역 회로 캐시. 같은 .dat 은 한 번만 로드해 여러 witness 작업이 공유한다 (Circom_Circuit 은 읽기 전용).
+// 키는 경로와 파일 정체 (dev / inode / 크기 / mtime) 이다. 파일이 바뀌었으면 옛 항목은 내리고 새로 로드한다.
+// fd 로 들어온 회로는 경로가 없으므로 파일 정체와 구간 (offset / length) 으로 찾는다 (fd 번호는 호출마다 다를 수 있다).
+// 참조가 0 이 되어도 unloadCircuit 전까지 남겨 둔다. 내린 항목은 빌려 간 곳이 모두 돌려줄 때 해제한다.
+struct CachedCircuit {
+    std::string path;   // fd 로 로드한 항목은 빈 문자열
+    uint64_t offset;    // fd 구간 (경로로 로드한 항목은 0, 0)
+    uint64_t length;
+    dev_t dev;
+    ino_t ino;
+    off_t size;
+    struct timespec mtime;
+    Circom_Circuit *circuit;
+    uint refs;
+    bool unloaded;  // 새로 빌려 줄 수 없음 (refs 가 0 이 되면 해제)
+};
+
+static std::mutex circuitCacheLock;
+// 회로 수만큼 (보통 1~2개). 프로세스가 끝날 때까지 살아 있는 항목을 가리키므로 일부러 소멸시키지 않는다
+static std::vector<CachedCircuit *> &circuitCache = *new std::vector<CachedCircuit *>();
+
+static bool sameFile(const CachedCircuit *e, const struct stat &sb) {
+    return e->dev == sb.st_dev && e->ino == sb.st_ino && e->size == sb.st_size &&
+           e->mtime.tv_sec == sb.st_mtim.tv_sec && e->mtime.tv_nsec == sb.st_mtim.tv_nsec;
+}
 
-    // 🔥 여기서 죽으면 파일 크기가 예상보다 작은 것
-    if (dsize > sb.st_size) {
-        LOGE("❌ CRITICAL: File is too small for InputHashMap! Need %u, File %ld", dsize, sb.st_size);
-        return nullptr; // 강제 종료 방지
-    }
-    memcpy((void *)(circuit->InputHashMap), (void *)bdata, dsize);
-    LOGD("✅ InputHashMap Loaded.");
+// circuitCacheLock 을 잡고 부른다. 빌려 간 곳이 없으면 바로 해제한다
+static void unloadCachedCircuit(size_t i) {
+    CachedCircuit *e = circuitCache[i];
+    e->unloaded = true;
+    if (e->refs > 0) return;
+    circuitCache.erase(circuitCache.begin() + i);
+    freeCircuit(e->circuit);
+    delete e;
+}
 
-    // 2. WitnessMap 로딩
-    LOGD("📂 Loading WitnessMap... Size: %u", get_size_of_witness());
-    circuit->witness2SignalList = new u64[get_size_of_witness()];
-    uint inisize = dsize;
-    dsize = get_size_of_witness()*sizeof(u64);
+// .dat 을 읽어 올 곳. path 가 비어 있으면 fd 의 [offset, offset + length) (length 0 = 파일 끝까지)
+struct DatSource {
+    std::string path;
+    int fd;
+    uint64_t offset;
+    uint64_t length;
+};
 
-    if (inisize + dsize > sb.st_size) {
-        LOGE("❌ CRITICAL: File is too small for WitnessMap! Offset %u, Need %u, File %ld", inisize, dsize, sb.st_size);
+// 캐시된 회로를 빌린다 (없거나 파일이 바뀌었으면 로드). 실패하면 nullptr. releaseCircuit 으로 돌려준다
+Circom_Circuit *acquireCircuit(DatSource src) {
+    bool byPath = !src.path.empty();
+    struct stat sb;
+    if (byPath ? stat(src.path.c_str(), &sb) == -1 : fstat(src.fd, &sb) == -1) {
+        LOGE("❌ Error: .dat file not found: %s", byPath ? src.path.c_str() : "(bad fd)");
         return nullptr;
     }
-    memcpy((void *)(circuit->witness2SignalList), (void *)(bdata+inisize), dsize);
-    LOGD("✅ WitnessMap Loaded.");
-
-    // 3. Constants 로딩
-    circuit->circuitConstants = new FrElement[get_size_of_constants()];
-    if (get_size_of_constants()>0) {
-        inisize += dsize;
-        dsize = get_size_of_constants()*sizeof(FrElement);
-        if (inisize + dsize > sb.st_size) {
-            LOGE("❌ CRITICAL: File too small for Constants!");
+    if (!byPath) {
+        // 같은 구간이 같은 키가 되도록 길이를 정한다
+        if ((uint64_t)sb.st_size <= src.offset) {
+            LOGE("❌ Error: .dat offset %llu is past the end of fd %d", (unsigned long long)src.offset, src.fd);
             return nullptr;
         }
-        memcpy((void *)(circuit->circuitConstants), (void *)(bdata+inisize), dsize);
+        if (src.length == 0) src.length = (uint64_t)sb.st_size - src.offset;
     }
-    LOGD("✅ Constants Loaded.");
 
-    // 4. IO Map (보통 없으므로 패스하거나 간단 처리)
-    std::map<u32,IOFieldDefPair> templateInsId2IOSignalInfo1;
-    if (get_size_of_io_map()>0) {
-        // ... (생략, 보통 0임) ...
+    std::lock_guard<std::mutex> guard(circuitCacheLock);
+    for (size_t i = 0; i < circuitCache.size(); i++) {
+        CachedCircuit *e = circuitCache[i];
+        if (e->unloaded || e->path != src.path) continue;
+        if (!byPath && (e->dev != sb.st_dev || e->ino != sb.st_ino ||
+                        e->offset != src.offset || e->length != src.length)) continue;
+        if (sameFile(e, sb)) {
+            e->refs++;
+            LOGD("📦 Circuit cache hit: %s (refs %u)", byPath ? src.path.c_str() : "fd range", e->refs);
+            return e->circuit;
+        }
+        LOGD("📦 Circuit file changed, reloading: %s", byPath ? src.path.c_str() : "fd range");
+        unloadCachedCircuit(i);
+        break;
     }
-    circuit->templateInsId2IOSignalInfo = move(templateInsId2IOSignalInfo1);
 
-    LOGD("✅ loadCircuit Finish Successfully.");
+    // 로드하는 동안에도 잠금을 쥐어 같은 파일을 두 번 로드하지 않는다 (zero-copy 로드는 수십 us)
+    Circom_Circuit *circuit = byPath ? loadCircuit(src.path) : loadCircuitFd(src.fd, src.offset, src.length);
+    if (!circuit) return nullptr;
+    CachedCircuit *e = new CachedCircuit();
+    e->path = src.path;
+    e->offset = byPath ? 0 : src.offset;
+    e->length = byPath ? 0 : src.length;
+    e->dev = sb.st_dev;
+    e->ino = sb.st_ino;
+    e->size = sb.st_size;
+    e->mtime = sb.st_mtim;
+    e->circuit = circuit;
+    e->refs = 1;
+    e->unloaded = false;
+    circuitCache.push_back(e);
     return circuit;
 }
 
-bool check_valid_number(std::string & s, uint base){
-    bool is_valid = true;
-    if (base == 16){
-        for (uint i = 0; i < s.size(); i++){
-            is_valid &= (('0' <= s[i] && s[i] <= '9') || ('a' <= s[i] && s[i] <= 'f') || ('A' <= s[i] && s[i] <= 'F'));
+Circom_Circuit *acquireCircuit(std::string const &datFileName) {
+    return acquireCircuit(DatSource{datFileName, -1, 0, 0});
+}
+
+void releaseCircuit(Circom_Circuit *circuit) {
+    if (!circuit) return;
+    std::lock_guard<std::mutex> guard(circuitCacheLock);
+    for (size_t i = 0; i < circuitCache.size(); i++) {
+        CachedCircuit *e = circuitCache[i];
+        if (e->circuit != circuit) continue;
+        e->refs--;
+        if (e->unloaded) unloadCachedCircuit(i);
+        return;
+    }
+}
+
+// 경로의 회로를 캐시에서 내린다 (빈 경로면 fd 로 로드한 것까지 전부). 사용 중인 것은 마지막 releaseCircuit 때 해제된다
+uint unloadCircuits(std::string const &datFileName) {
+    std::lock_guard<std::mutex> guard(circuitCacheLock);
+    uint n = 0;
+    for (size_t i = circuitCache.size(); i-- > 0;) {
+        CachedCircuit *e = circuitCache[i];
+        if (e->unloaded || (!datFileName.empty() && e->path != datFileName)) continue;
+        unloadCachedCircuit(i);
+        n++;
+    }
+    return n;
+}
+
+// 접두사 0b / 0o / 0x 로 진법을 정하고 GMP 없이 바로 원소로 읽는다
+static void str2FrElement(const std::string &str, FrElement &v) {
+    const char *s = str.c_str();
+    uint base = 10;
+    if (str.size() > 2 && s[0] == '0') {
+        char p = s[1] | 0x20;
+        if (p == 'b') base = 2;
+        else if (p == 'o') base = 8;
+        else if (p == 'x') base = 16;
+        if (base != 10) s += 2;
+    }
+    if (!Fr_str2element(&v, s, base)) throw std::runtime_error("Invalid number in JSON");
+}
+
+// 정수 JSON 값은 double 을 거치지 않고 그대로 읽는다.
+// i64/u64 를 넘는 숫자는 nlohmann 이 double 로 저장해 정밀도를 잃으므로 문자열로 받아야 한다.
+static void number2FrElement(const json &val, FrElement &v) {
+    int64_t iv;
+    if (val.is_number_unsigned()) {
+        uint64_t uv = val.get<uint64_t>();
+        if (uv > (uint64_t)INT64_MAX) {
+            v.shortVal = 0;
+            v.type = Fr_LONG;
+            v.longVal[0] = uv; v.longVal[1] = 0; v.longVal[2] = 0; v.longVal[3] = 0;
+            return;
         }
-    } else{
-        for (uint i = 0; i < s.size(); i++){
-            is_valid &= ('0' <= s[i] && s[i] < char(int('0') + base));
+        iv = (int64_t)uv;
+    } else if (val.is_number_integer()) {
+        iv = val.get<int64_t>();
+    } else {
+        double vd = val.get<double>();
+        if (!(vd >= -9007199254740992.0 && vd <= 9007199254740992.0) || vd != (double)(int64_t)vd) {
+            throw std::runtime_error("Non-integer or too large JSON number, pass it as a string");
         }
+        iv = (int64_t)vd;
+    }
+    if (iv >= INT32_MIN && iv <= INT32_MAX) {
+        v.shortVal = (int32_t)iv;
+        v.type = Fr_SHORT;
+        return;
     }
-    return is_valid;
+    FrElement m = {0, Fr_LONG, {iv >= 0 ? (uint64_t)iv : 0 - (uint64_t)iv, 0, 0, 0}};
+    if (iv >= 0) v = m;
+    else Fr_neg(&v, &m);
 }
 
-void json2FrElements (json val, std::vector<FrElement> & vval){
+void json2FrElements (const json &val, std::vector<FrElement> & vval){
     if (!val.is_array()) {
         FrElement v;
-        std::string s_aux, s;
-        uint base;
         if (val.is_string()) {
-            s_aux = val.get<std::string>();
-            std::string possible_prefix = s_aux.substr(0, 2);
-            if (possible_prefix == "0b" || possible_prefix == "0B"){ s = s_aux.substr(2); base = 2; }
-            else if (possible_prefix == "0o" || possible_prefix == "0O"){ s = s_aux.substr(2); base = 8; }
-            else if (possible_prefix == "0x" || possible_prefix == "0X"){ s = s_aux.substr(2); base = 16; }
-            else{ s = s_aux; base = 10; }
-            if (!check_valid_number(s, base)) throw std::runtime_error("Invalid number in JSON");
+            str2FrElement(val.get_ref<const std::string &>(), v);
         } else if (val.is_number()) {
-            double vd = val.get<double>();
-            std::stringstream stream;
-            stream << std::fixed << std::setprecision(0) << vd;
-            s = stream.str();
-            base = 10;
+            number2FrElement(val, v);
         } else {
             throw std::runtime_error("Invalid JSON type");
         }
-        Fr_str2element (&v, s.c_str(), base);
         vval.push_back(v);
     } else {
         for (uint i = 0; i < val.size(); i++) json2FrElements (val[i], vval);
@@ -151,16 +368,26 @@ void parseJsonInput(Circom_CalcWit *ctx, std::string jsonString) {
     if (nItems == 0){
         ctx->tryRunCircuit();
     }
+    std::vector<FrElement> v;
     for (json::iterator it = j.begin(); it != j.end(); ++it) {
-        u64 h = fnv1a(it.key());
-        std::vector<FrElement> v;
+        const HashSignalInfo *input = ctx->resolveInput(it.key());
+        if (!input) throw std::runtime_error("Unknown input signal " + it.key());
+        v.clear();
         json2FrElements(it.value(),v);
-        uint signalSize = ctx->getInputSignalSize(h);
+        uint signalSize = input->signalsize;
         if (v.size() < signalSize) throw std::runtime_error("Not enough values for " + it.key());
         if (v.size() > signalSize) throw std::runtime_error("Too many values for " + it.key());
-        for (uint i = 0; i<v.size(); i++){
-            ctx->setInputSignal(h,i,v[i]);
-        }
+        ctx->setInputSignals(input, v.data(), v.size());
+    }
+}
+
+// .wtns 쓰기에 실패하면 반쯤 쓴 파일을 지우고 예외로 알린다 (남은 파일로 증명하지 않도록)
+static void wtnsWrite(FILE *f, std::string const &path, const void *p, size_t size, size_t n) {
+    if (fwrite(p, size, n, f) != n) {
+        LOGE("Error writing output file: %s", path.c_str());
+        fclose(f);
+        remove(path.c_str());
+        throw std::runtime_error("Failed to write witness file " + path);
     }
 }
 
@@ -168,53 +395,137 @@ void writeBinWitness(Circom_CalcWit *ctx, std::string wtnsFileName) {
     FILE *write_ptr = fopen(wtnsFileName.c_str(),"wb");
     if (!write_ptr) {
         LOGE("Error opening output file: %s", wtnsFileName.c_str());
-        return;
+        throw std::runtime_error("Failed to open witness file " + wtnsFileName);
     }
-    fwrite("wtns", 4, 1, write_ptr);
-    u32 version = 2; fwrite(&version, 4, 1, write_ptr);
-    u32 nSections = 2; fwrite(&nSections, 4, 1, write_ptr);
-    u32 idSection1 = 1; fwrite(&idSection1, 4, 1, write_ptr);
+    u32 version = 2;
+    u32 nSections = 2;
+    u32 idSection1 = 1;
     u32 n8 = Fr_N64*8;
-    u64 idSection1length = 8 + n8; fwrite(&idSection1length, 8, 1, write_ptr);
-    fwrite(&n8, 4, 1, write_ptr);
-    fwrite(Fr_q.longVal, Fr_N64*8, 1, write_ptr);
+    u64 idSection1length = 8 + n8;
     uint Nwtns = get_size_of_witness();
-    u32 nVars = (u32)Nwtns; fwrite(&nVars, 4, 1, write_ptr);
-    u32 idSection2 = 2; fwrite(&idSection2, 4, 1, write_ptr);
-    u64 idSection2length = (u64)n8*(u64)Nwtns; fwrite(&idSection2length, 8, 1, write_ptr);
-    FrElement v;
-    for (int i=0;i<Nwtns;i++) {
-        ctx->getWitness(i, &v);
-        Fr_toLongNormal(&v, &v);
-        fwrite(v.longVal, Fr_N64*8, 1, write_ptr);
-    }
-    fclose(write_ptr);
+    u32 nVars = (u32)Nwtns;
+    u32 idSection2 = 2;
+    u64 idSection2length = (u64)n8*(u64)Nwtns;
+    wtnsWrite(write_ptr, wtnsFileName, "wtns", 4, 1);
+    wtnsWrite(write_ptr, wtnsFileName, &version, 4, 1);
+    wtnsWrite(write_ptr, wtnsFileName, &nSections, 4, 1);
+    wtnsWrite(write_ptr, wtnsFileName, &idSection1, 4, 1);
+    wtnsWrite(write_ptr, wtnsFileName, &idSection1length, 8, 1);
+    wtnsWrite(write_ptr, wtnsFileName, &n8, 4, 1);
+    wtnsWrite(write_ptr, wtnsFileName, Fr_q.longVal, Fr_N64*8, 1);
+    wtnsWrite(write_ptr, wtnsFileName, &nVars, 4, 1);
+    wtnsWrite(write_ptr, wtnsFileName, &idSection2, 4, 1);
+    wtnsWrite(write_ptr, wtnsFileName, &idSection2length, 8, 1);
+    // witness 값은 run 을 따라 신호를 차례로 읽어 묶음으로 쓴다
+    const uint batch = 1024;
+    std::vector<u64> buf((size_t)batch * Fr_N64);
+    uint filled = 0;
+    FrElement tmp, v;
+    const std::vector<Circom_WitnessRun> &runs = ctx->circuit->witnessRuns;
+    for (size_t r = 0; r < runs.size(); r++) {
+        u64 end = runs[r].signal + runs[r].count;
+        for (u64 sig = runs[r].signal; sig < end; sig++) {
+            Fr_toLongNormal(&v, ctx->loadSignal(sig, &tmp));
+            memcpy(&buf[(size_t)filled * Fr_N64], v.longVal, Fr_N64 * 8);
+            if (++filled == batch) {
+                wtnsWrite(write_ptr, wtnsFileName, buf.data(), Fr_N64 * 8, filled);
+                filled = 0;
+            }
+        }
+    }
+    if (filled) wtnsWrite(write_ptr, wtnsFileName, buf.data(), Fr_N64 * 8, filled);
+    if (fclose(write_ptr) != 0) {
+        LOGE("Error closing output file: %s", wtnsFileName.c_str());
+        remove(wtnsFileName.c_str());
+        throw std::runtime_error("Failed to close witness file " + wtnsFileName);
+    }
 }
 
-// -------------------------------------------------------------------------
-// JNI Implementation
-// -------------------------------------------------------------------------
+#ifdef FR_PATH_STATS
+// Fr 연산별 short / 승격 / long 경로 사용 횟수를 logcat 으로 출력
+void logFrPathStats() {
+    static const char *opNames[Fr_OP_COUNT] = {"add", "sub", "mul", "neg", "cmp"};
+    uint64_t stats[Fr_OP_COUNT][Fr_PATH_COUNT];
+    Fr_getPathStats(stats);
+    for (int op = 0; op < Fr_OP_COUNT; op++) {
+        LOGI("📊 Fr_%s: short=%llu promote=%llu long=%llu", opNames[op],
+             (unsigned long long)stats[op][Fr_PATH_SHORT],
+             (unsigned long long)stats[op][Fr_PATH_PROMOTE],
+             (unsigned long long)stats[op][Fr_PATH_LONG]);
+    }
+}
+#endif
+
+#ifdef CIRCOM_PROFILE
+// 줄별 프로파일을 logcat 에 시간 순으로 찍고, 전체를 JSON 파일로 남긴다
+void logProfile(std::string const &jsonPath) {
+    std::string text = Circom_profReportText(40);
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        LOGI("⏱ %s", text.substr(start, end - start).c_str());
+        start = end + 1;
+    }
+    std::ofstream out(jsonPath);
+    out << Circom_profReportJson();
+    LOGI("⏱ Profile written: %s", jsonPath.c_str());
+}
+#endif
+
+// 입력 JSON 을 넣어 회로를 실행하고 .wtns 로 쓴다. 실패하면 예외
+void computeWitness(Circom_CalcWit *ctx, const char *input_json, const char *wtns_path) {
+#ifdef FR_PATH_STATS
+    Fr_resetPathStats();
+#endif
+#ifdef CIRCOM_PROFILE
+    Circom_profReset();
+#endif
+
+    LOGD("🚀 Parsing JSON Input...");
+    Fr_clearError();
+    parseJsonInput(ctx, std::string(input_json));
+
+    if (Fr_getError() == Fr_ERR_DIV_BY_ZERO) {
+        throw std::runtime_error("Division by zero while computing witness");
+    }
+    if (Fr_getError() == Fr_ERR_TOINT) {
+        throw std::runtime_error("Signal index or integer value out of range while computing witness");
+    }
 
-extern "C" JNIEXPORT jboolean JNICALL
-Java_com_example_contacticalattestation_zk_NativeWitness_calcWitness(
-        JNIEnv* env,
-        jobject /* this */,
-        jstring inputJsonStr,
-        jstring datPathStr,
-        jstring wtnsPathStr) {
+    if (ctx->getRemaingInputsToBeSet() != 0) {
+        throw std::runtime_error("Not all inputs set!");
+    }
 
-    const char *input_json = env->GetStringUTFChars(inputJsonStr, 0);
-    const char *dat_path = env->GetStringUTFChars(datPathStr, 0);
-    const char *wtns_path = env->GetStringUTFChars(wtnsPathStr, 0);
+    LOGD("🚀 Writing Witness to file...");
+    writeBinWitness(ctx, wtns_path);
+
+#ifdef FR_PATH_STATS
+    logFrPathStats();
+#endif
+#ifdef CIRCOM_PROFILE
+    logProfile(std::string(wtns_path) + ".prof.json");
+#endif
+}
+
+// JNI 가 들고 있는 재사용 컨텍스트. 같은 핸들로 동시에 들어온 호출은 lock 으로 줄 세운다
+struct WitnessHandle {
+    Circom_Circuit *circuit;
+    Circom_CalcWit *ctx;
+    std::mutex lock;
+};
 
+// 회로를 빌려 witness 를 한 번 계산하고 돌려준다 (calcWitness / calcWitnessFd 공용)
+static bool calcWitnessFrom(DatSource const &src, const char *input_json, const char *wtns_path) {
     LOGD("🚀 Starting Witness Calculation (Heap Mode)...");
 
     Circom_Circuit *circuit = nullptr;
     Circom_CalcWit *ctx = nullptr;
+    bool ok = true;
 
     try {
-        // 1. Load Circuit
-        circuit = loadCircuit(dat_path);
+        // 1. Load Circuit (캐시에 있으면 재사용)
+        circuit = acquireCircuit(src);
         if (!circuit) {
             throw std::runtime_error("Failed to load circuit .dat file (Check logs above)");
         }
@@ -224,36 +535,191 @@ Java_com_example_contacticalattestation_zk_NativeWitness_calcWitness(
         ctx = new Circom_CalcWit(circuit, 1);
         LOGD("✅ Circom_CalcWit Created.");
 
-        // 3. Parse JSON
-        LOGD("🚀 Parsing JSON Input...");
-        parseJsonInput(ctx, std::string(input_json));
+        // 3. Parse JSON + Write Witness
+        computeWitness(ctx, input_json, wtns_path);
 
-        if (ctx->getRemaingInputsToBeSet() != 0) {
-            throw std::runtime_error("Not all inputs set!");
-        }
+        LOGI("✅ Witness Generation Successful!");
+
+    } catch (const std::exception& e) {
+        LOGE("❌ Witness Error: %s", e.what());
+        ok = false;
+    }
 
-        // 4. Write Witness
-        LOGD("🚀 Writing Witness to file...");
-        writeBinWitness(ctx, wtns_path);
+    delete ctx;
+    releaseCircuit(circuit);
+    return ok;
+}
 
-        LOGD("✅ Witness Generation Successful!");
+// 회로를 빌려 Circom_CalcWit 를 만든다. 실패하면 nullptr (createContext / createContextFd 공용)
+static WitnessHandle *createWitnessHandle(DatSource const &src, jint numThreads) {
+    WitnessHandle *handle = nullptr;
 
+    try {
+        Circom_Circuit *circuit = acquireCircuit(src);
+        if (!circuit) {
+            throw std::runtime_error("Failed to load circuit .dat file (Check logs above)");
+        }
+        handle = new WitnessHandle();
+        handle->circuit = circuit;
+        uint nThreads = numThreads > 0 ? (uint)numThreads : std::thread::hardware_concurrency();
+        handle->ctx = new Circom_CalcWit(circuit, nThreads);
+        LOGD("✅ Witness context created: %p", handle);
     } catch (const std::exception& e) {
-        LOGE("❌ Witness Error: %s", e.what());
-        if (ctx) delete ctx;
-        if (circuit) delete circuit;
-        env->ReleaseStringUTFChars(inputJsonStr, input_json);
-        env->ReleaseStringUTFChars(datPathStr, dat_path);
-        env->ReleaseStringUTFChars(wtnsPathStr, wtns_path);
+        LOGE("❌ Witness Context Error: %s", e.what());
+        if (handle) {
+            releaseCircuit(handle->circuit);
+            delete handle;
+            handle = nullptr;
+        }
+    }
+    return handle;
+}
+
+// -------------------------------------------------------------------------
+// JNI Implementation
+// -------------------------------------------------------------------------
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_contacticalattestation_zk_NativeWitness_calcWitness(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring inputJsonStr,
+        jstring datPathStr,
+        jstring wtnsPathStr) {
+
+    const char *input_json = env->GetStringUTFChars(inputJsonStr, 0);
+    const char *dat_path = env->GetStringUTFChars(datPathStr, 0);
+    const char *wtns_path = env->GetStringUTFChars(wtnsPathStr, 0);
+
+    bool ok = calcWitnessFrom(DatSource{dat_path, -1, 0, 0}, input_json, wtns_path);
+
+    env->ReleaseStringUTFChars(inputJsonStr, input_json);
+    env->ReleaseStringUTFChars(datPathStr, dat_path);
+    env->ReleaseStringUTFChars(wtnsPathStr, wtns_path);
+    return ok;
+}
+
+// calcWitness 와 같지만 .dat 을 열린 fd 의 [datOffset, datOffset + datLength) 에서 매핑한다 (datLength 0 = 끝까지).
+// fd 는 호출이 끝나면 닫아도 된다
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_contacticalattestation_zk_NativeWitness_calcWitnessFd(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring inputJsonStr,
+        jint datFd,
+        jlong datOffset,
+        jlong datLength,
+        jstring wtnsPathStr) {
+
+    if (datFd < 0 || datOffset < 0 || datLength < 0) {
+        LOGE("❌ Witness Error: invalid .dat range: fd %d [%lld +%lld]", (int)datFd,
+             (long long)datOffset, (long long)datLength);
         return false;
     }
 
-    if (ctx) delete ctx;
-    // circuit은 ctx 내에서 참조되므로 별도 해제는 loadCircuit 구조에 따라 결정
-    // 여기선 OS 회수에 맡기거나 필요한 경우 delete circuit;
+    const char *input_json = env->GetStringUTFChars(inputJsonStr, 0);
+    const char *wtns_path = env->GetStringUTFChars(wtnsPathStr, 0);
+
+    bool ok = calcWitnessFrom(DatSource{std::string(), (int)datFd, (uint64_t)datOffset, (uint64_t)datLength},
+                              input_json, wtns_path);
 
     env->ReleaseStringUTFChars(inputJsonStr, input_json);
+    env->ReleaseStringUTFChars(wtnsPathStr, wtns_path);
+    return ok;
+}
+
+// 회로를 한 번 로드하고 Circom_CalcWit 를 만들어 핸들로 돌려준다. 실패하면 0
+// numThreads 는 병렬 컴포넌트용 스레드 수 (호출 스레드 포함), 0 이하면 코어 수
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_example_contacticalattestation_zk_NativeWitness_createContext(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring datPathStr,
+        jint numThreads) {
+
+    const char *dat_path = env->GetStringUTFChars(datPathStr, 0);
+    WitnessHandle *handle = createWitnessHandle(DatSource{dat_path, -1, 0, 0}, numThreads);
     env->ReleaseStringUTFChars(datPathStr, dat_path);
+    return (jlong)(intptr_t)handle;
+}
+
+// createContext 와 같지만 .dat 을 열린 fd 의 구간에서 매핑한다. 핸들은 fd 를 쥐지 않는다
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_example_contacticalattestation_zk_NativeWitness_createContextFd(
+        JNIEnv* /* env */,
+        jobject /* this */,
+        jint datFd,
+        jlong datOffset,
+        jlong datLength,
+        jint numThreads) {
+
+    if (datFd < 0 || datOffset < 0 || datLength < 0) {
+        LOGE("❌ Witness Context Error: invalid .dat range: fd %d [%lld +%lld]", (int)datFd,
+             (long long)datOffset, (long long)datLength);
+        return 0;
+    }
+    WitnessHandle *handle = createWitnessHandle(
+            DatSource{std::string(), (int)datFd, (uint64_t)datOffset, (uint64_t)datLength}, numThreads);
+    return (jlong)(intptr_t)handle;
+}
+
+// 핸들의 버퍼를 reset() 으로 재사용해 witness 를 계산한다
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_contacticalattestation_zk_NativeWitness_calcWitnessWithContext(
+        JNIEnv* env,
+        jobject /* this */,
+        jlong handlePtr,
+        jstring inputJsonStr,
+        jstring wtnsPathStr) {
+
+    WitnessHandle *handle = (WitnessHandle *)(intptr_t)handlePtr;
+    if (!handle) {
+        LOGE("❌ Witness Error: null context");
+        return false;
+    }
+
+    const char *input_json = env->GetStringUTFChars(inputJsonStr, 0);
+    const char *wtns_path = env->GetStringUTFChars(wtnsPathStr, 0);
+    bool ok = true;
+
+    try {
+        std::lock_guard<std::mutex> guard(handle->lock);
+        handle->ctx->reset();
+        computeWitness(handle->ctx, input_json, wtns_path);
+    } catch (const std::exception& e) {
+        LOGE("❌ Witness Error: %s", e.what());
+        ok = false;
+    }
+
+    env->ReleaseStringUTFChars(inputJsonStr, input_json);
     env->ReleaseStringUTFChars(wtnsPathStr, wtns_path);
-    return true;
-}
\ No newline at end of file
+    return ok;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_contacticalattestation_zk_NativeWitness_releaseContext(
+        JNIEnv* /* env */,
+        jobject /* this */,
+        jlong handlePtr) {
+
+    WitnessHandle *handle = (WitnessHandle *)(intptr_t)handlePtr;
+    if (!handle) return;
+    LOGD("💀 Releasing witness context: %p", handle);
+    delete handle->ctx;
+    releaseCircuit(handle->circuit);
+    delete handle;
+}
+
+// 캐시된 회로를 내린다 (빈 문자열이면 전부). 내린 항목 수를 돌려준다
+extern "C" JNIEXPORT jint JNICALL
+Java_com_example_contacticalattestation_zk_NativeWitness_unloadCircuit(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring datPathStr) {
+
+    const char *dat_path = env->GetStringUTFChars(datPathStr, 0);
+    uint n = unloadCircuits(dat_path);
+    LOGD("💀 Unloaded %u cached circuit(s): %s", n, dat_path);
+    env->ReleaseStringUTFChars(datPathStr, dat_path);
+    return (jint)n;
+}
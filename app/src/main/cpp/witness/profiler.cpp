@@ -0,0 +1,268 @@
+#include "profiler.hpp"
+
+#ifdef CIRCOM_PROFILE
+
+#include <stdio.h>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include "circom.hpp"
+#include "../nlohmann/json.hpp"
+
+#define NO_TEMPLATE 0xffffffffu
+
+static const char *opNames[Circom_PROF_OP_COUNT] = {
+        "add", "sub", "neg", "mul", "square", "muladd", "acc", "div", "inv", "pow",
+        "cmp", "logic", "bit", "shift", "idiv"
+};
+
+struct ProfLine {
+    uint64_t ns = 0;
+    uint64_t hits = 0;
+    uint64_t ops[Circom_PROF_OP_COUNT] = {0};
+};
+
+struct ProfTemplate {
+    uint64_t ns = 0;      // 하위 템플릿 포함
+    uint64_t calls = 0;
+};
+
+// 스레드별 통계. 스레드가 끝나도 보고서에 남도록 registry 가 소유한다
+struct ProfThread {
+    std::unordered_map<uint64_t, ProfLine> lines;   // key = (templateId << 32) | line
+    std::unordered_map<uint32_t, ProfTemplate> templates;
+    uint32_t curTemplate = NO_TEMPLATE;
+    uint32_t curLine = 0;
+    ProfLine *cur = nullptr;
+    uint64_t lastTick = 0;
+};
+
+static std::mutex registryLock;
+static std::vector<ProfThread *> registry;
+static thread_local ProfThread *tls = nullptr;
+
+static inline uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline uint64_t lineKey(uint32_t templateId, uint32_t line) {
+    return ((uint64_t)templateId << 32) | line;
+}
+
+static inline ProfThread *me() {
+    if (!tls) {
+        tls = new ProfThread();
+        std::lock_guard<std::mutex> guard(registryLock);
+        registry.push_back(tls);
+    }
+    return tls;
+}
+
+// 직전 표시 이후의 시간을 현재 줄에 더한다 (템플릿 밖의 시간은 세지 않는다)
+static inline void charge(ProfThread *t, uint64_t now) {
+    if (t->cur && t->curTemplate != NO_TEMPLATE) t->cur->ns += now - t->lastTick;
+    t->lastTick = now;
+}
+
+static inline void setLine(ProfThread *t, uint32_t templateId, uint32_t line) {
+    t->curTemplate = templateId;
+    t->curLine = line;
+    t->cur = &t->lines[lineKey(templateId, line)];
+}
+
+void Circom_profLine(uint32_t line) {
+    ProfThread *t = me();
+    charge(t, nowNs());
+    setLine(t, t->curTemplate, line);
+    t->cur->hits++;
+}
+
+void Circom_profOps(int op, uint64_t n) {
+    ProfThread *t = me();
+    if (!t->cur) setLine(t, NO_TEMPLATE, 0);
+    t->cur->ops[op] += n;
+}
+
+// 호출 사이 (풀 스레드가 놀고 있을 때) 에만 부른다
+void Circom_profReset() {
+    std::lock_guard<std::mutex> guard(registryLock);
+    for (size_t i = 0; i < registry.size(); i++) {
+        registry[i]->lines.clear();
+        registry[i]->templates.clear();
+        registry[i]->curTemplate = NO_TEMPLATE;
+        registry[i]->curLine = 0;
+        registry[i]->cur = nullptr;
+    }
+}
+
+Circom_ProfTemplateScope::Circom_ProfTemplateScope(uint32_t templateId) {
+    ProfThread *t = me();
+    uint64_t now = nowNs();
+    charge(t, now);
+    savedTemplate = t->curTemplate;
+    savedLine = t->curLine;
+    start = now;
+    t->templates[templateId].calls++;
+    setLine(t, templateId, 0);
+}
+
+Circom_ProfTemplateScope::~Circom_ProfTemplateScope() {
+    ProfThread *t = me();
+    uint64_t now = nowNs();
+    charge(t, now);
+    t->templates[t->curTemplate].ns += now - start;
+    setLine(t, savedTemplate, savedLine);
+}
+
+// ---- 보고서 ----
+
+struct LineRow {
+    uint32_t templateId;
+    uint32_t line;
+    ProfLine stat;
+};
+
+struct TemplateRow {
+    uint32_t templateId;
+    ProfTemplate stat;
+    uint64_t selfNs;
+};
+
+static const char *templateName(uint32_t templateId) {
+    return templateId == NO_TEMPLATE ? "(outside)" : get_template_name(templateId);
+}
+
+static void collect(std::vector<TemplateRow> &templates, std::vector<LineRow> &lines, uint64_t totals[Circom_PROF_OP_COUNT]) {
+    std::unordered_map<uint64_t, ProfLine> mergedLines;
+    std::unordered_map<uint32_t, ProfTemplate> mergedTemplates;
+    {
+        std::lock_guard<std::mutex> guard(registryLock);
+        for (size_t i = 0; i < registry.size(); i++) {
+            for (auto &it : registry[i]->lines) {
+                ProfLine &m = mergedLines[it.first];
+                m.ns += it.second.ns;
+                m.hits += it.second.hits;
+                for (int op = 0; op < Circom_PROF_OP_COUNT; op++) m.ops[op] += it.second.ops[op];
+            }
+            for (auto &it : registry[i]->templates) {
+                ProfTemplate &m = mergedTemplates[it.first];
+                m.ns += it.second.ns;
+                m.calls += it.second.calls;
+            }
+        }
+    }
+
+    for (int op = 0; op < Circom_PROF_OP_COUNT; op++) totals[op] = 0;
+    std::unordered_map<uint32_t, uint64_t> selfNs;
+    for (auto &it : mergedLines) {
+        LineRow row = {(uint32_t)(it.first >> 32), (uint32_t)it.first, it.second};
+        if (row.stat.hits == 0 && row.stat.ns == 0) {
+            // 템플릿 입구 (줄 0) 에 연산도 시간도 없으면 생략
+            bool any = false;
+            for (int op = 0; op < Circom_PROF_OP_COUNT; op++) any |= row.stat.ops[op] != 0;
+            if (!any) continue;
+        }
+        for (int op = 0; op < Circom_PROF_OP_COUNT; op++) totals[op] += row.stat.ops[op];
+        selfNs[row.templateId] += row.stat.ns;
+        lines.push_back(row);
+    }
+    for (auto &it : mergedTemplates) {
+        TemplateRow row = {it.first, it.second, selfNs[it.first]};
+        templates.push_back(row);
+    }
+
+    std::sort(lines.begin(), lines.end(), [](const LineRow &a, const LineRow &b) {
+        return a.stat.ns != b.stat.ns ? a.stat.ns > b.stat.ns : a.stat.hits > b.stat.hits;
+    });
+    std::sort(templates.begin(), templates.end(), [](const TemplateRow &a, const TemplateRow &b) {
+        return a.selfNs > b.selfNs;
+    });
+}
+
+static std::string opsText(const uint64_t ops[Circom_PROF_OP_COUNT]) {
+    std::string s;
+    char buf[64];
+    for (int op = 0; op < Circom_PROF_OP_COUNT; op++) {
+        if (!ops[op]) continue;
+        snprintf(buf, sizeof(buf), "%s%s=%llu", s.empty() ? "" : " ", opNames[op], (unsigned long long)ops[op]);
+        s += buf;
+    }
+    return s;
+}
+
+std::string Circom_profReportText(size_t maxLines) {
+    std::vector<TemplateRow> templates;
+    std::vector<LineRow> lines;
+    uint64_t totals[Circom_PROF_OP_COUNT];
+    collect(templates, lines, totals);
+
+    uint64_t totalNs = 0;
+    for (size_t i = 0; i < lines.size(); i++) totalNs += lines[i].stat.ns;
+    double pct = totalNs ? 100.0 / (double)totalNs : 0;
+
+    std::string out;
+    char buf[256];
+    snprintf(buf, sizeof(buf), "line time %.3f ms, ops: %s\n", totalNs / 1e6, opsText(totals).c_str());
+    out += buf;
+    for (size_t i = 0; i < templates.size(); i++) {
+        const TemplateRow &t = templates[i];
+        snprintf(buf, sizeof(buf), "template %-24s calls=%llu total=%.3f ms self=%.3f ms (%.1f%%)\n",
+                 templateName(t.templateId), (unsigned long long)t.stat.calls,
+                 t.stat.ns / 1e6, t.selfNs / 1e6, t.selfNs * pct);
+        out += buf;
+    }
+    for (size_t i = 0; i < lines.size() && i < maxLines; i++) {
+        const LineRow &l = lines[i];
+        snprintf(buf, sizeof(buf), "line %s:%u hits=%llu time=%.3f ms (%.1f%%) ",
+                 templateName(l.templateId), l.line, (unsigned long long)l.stat.hits,
+                 l.stat.ns / 1e6, l.stat.ns * pct);
+        out += buf;
+        out += opsText(l.stat.ops);
+        out += "\n";
+    }
+    return out;
+}
+
+std::string Circom_profReportJson() {
+    std::vector<TemplateRow> templates;
+    std::vector<LineRow> lines;
+    uint64_t totals[Circom_PROF_OP_COUNT];
+    collect(templates, lines, totals);
+
+    nlohmann::json j;
+    nlohmann::json ops = nlohmann::json::object();
+    for (int op = 0; op < Circom_PROF_OP_COUNT; op++) ops[opNames[op]] = totals[op];
+    j["ops"] = ops;
+
+    j["templates"] = nlohmann::json::array();
+    for (size_t i = 0; i < templates.size(); i++) {
+        const TemplateRow &t = templates[i];
+        j["templates"].push_back({
+                {"id", t.templateId == NO_TEMPLATE ? -1 : (int64_t)t.templateId},
+                {"name", templateName(t.templateId)},
+                {"calls", t.stat.calls},
+                {"total_ns", t.stat.ns},
+                {"self_ns", t.selfNs}});
+    }
+
+    j["lines"] = nlohmann::json::array();
+    for (size_t i = 0; i < lines.size(); i++) {
+        const LineRow &l = lines[i];
+        nlohmann::json lineOps = nlohmann::json::object();
+        for (int op = 0; op < Circom_PROF_OP_COUNT; op++) {
+            if (l.stat.ops[op]) lineOps[opNames[op]] = l.stat.ops[op];
+        }
+        j["lines"].push_back({
+                {"template", templateName(l.templateId)},
+                {"line", l.line},
+                {"hits", l.stat.hits},
+                {"ns", l.stat.ns},
+                {"ops", lineOps}});
+    }
+    return j.dump(1);
+}
+
+#endif // CIRCOM_PROFILE
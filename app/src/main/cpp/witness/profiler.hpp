@@ -0,0 +1,71 @@
+#ifndef CIRCOM_PROFILER_HPP
+#define CIRCOM_PROFILER_HPP
+
+// circom 소스 줄 단위 프로파일러 (CIRCOM_PROFILE 로 빌드했을 때만, 아니면 매크로가 모두 사라진다).
+//
+// 생성 코드는 Fr 호출마다 CIRCOM_PROF_LINE(n) 을 찍고, *_run 입구에 CIRCOM_PROF_TEMPLATE(id) 를 둔다
+// (circom 출력의 "// line circom n" 주석을 보고 circom_postprocess.py 의 profile 변환이 넣는다).
+// 시간은 "줄 시계" 방식: 표시를 만날 때마다 직전 표시 이후의 경과 시간을 직전 줄에 더한다.
+// 하위 템플릿이 실행되는 동안은 부모 줄의 시계를 멈추므로, 줄 시간은 그 템플릿의 self 시간이 된다.
+// Fr 연산 수는 fr.cpp 의 CIRCOM_PROF_OP 가 종류별로 세어 현재 줄에 붙인다
+// (배열 연산 Fr_*n 은 스칼라로 처리되는 원소만 잡힌다).
+// 통계는 스레드별로 쌓고 보고서를 만들 때 합친다.
+
+#include <stdint.h>
+#include <string>
+
+enum {
+    Circom_PROF_ADD,
+    Circom_PROF_SUB,
+    Circom_PROF_NEG,
+    Circom_PROF_MUL,
+    Circom_PROF_SQUARE,
+    Circom_PROF_MULADD,
+    Circom_PROF_ACC,
+    Circom_PROF_DIV,
+    Circom_PROF_INV,
+    Circom_PROF_POW,
+    Circom_PROF_CMP,
+    Circom_PROF_LOGIC,
+    Circom_PROF_BIT,
+    Circom_PROF_SHIFT,
+    Circom_PROF_IDIV,
+    Circom_PROF_OP_COUNT
+};
+
+#ifdef CIRCOM_PROFILE
+
+void Circom_profLine(uint32_t line);
+void Circom_profOps(int op, uint64_t n);
+void Circom_profReset();
+
+// 템플릿 실행 구간. 들어올 때 부모의 줄 시계를 멈추고, 나갈 때 되돌린다
+class Circom_ProfTemplateScope {
+public:
+    explicit Circom_ProfTemplateScope(uint32_t templateId);
+    ~Circom_ProfTemplateScope();
+private:
+    uint32_t savedTemplate;
+    uint32_t savedLine;
+    uint64_t start;
+};
+
+// 보고서: 템플릿별 / 줄별 시간 순으로 정렬한 텍스트와 JSON
+std::string Circom_profReportText(size_t maxLines);
+std::string Circom_profReportJson();
+
+#define CIRCOM_PROF_LINE(n) Circom_profLine(n)
+#define CIRCOM_PROF_TEMPLATE(id) Circom_ProfTemplateScope __profScope(id)
+#define CIRCOM_PROF_OP(op) Circom_profOps(op, 1)
+#define CIRCOM_PROF_OPS(op, n) Circom_profOps(op, n)
+
+#else
+
+#define CIRCOM_PROF_LINE(n) ((void)0)
+#define CIRCOM_PROF_TEMPLATE(id) ((void)0)
+#define CIRCOM_PROF_OP(op) ((void)0)
+#define CIRCOM_PROF_OPS(op, n) ((void)0)
+
+#endif // CIRCOM_PROFILE
+
+#endif // CIRCOM_PROFILER_HPP
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# RealRSALike (jwt_verifier.cpp) witness 를 Python 정수로 따로 계산해 witness-check 의 기준 파일을 만든다.
+# fr.cpp 를 쓰지 않으므로 네이티브 Fr 연산과 독립된 기준이다. 회로나 circuit.dat 을 바꾸면 다시 만든다.
+# 사용법: realrsalike_model.py <circuit.dat (version 2 컨테이너)> <입력 json> > realrsalike.ref
+import json
+import struct
+import sys
+
+Q = 21888242871839275222246405745257275088548364400416034343698204186575808495617
+R_INV = pow(2 ** 256, -1, Q)
+FNV_PRIME = 0x100000001B3
+MASK64 = 2 ** 64 - 1
+
+
+def checksum(data, h=0xCBF29CE484222325):
+    # datfile.cpp 의 Circom_datChecksum (8바이트 단위 FNV-1a, 자투리는 0 으로 채운다)
+    if len(data) % 8:
+        data = data + bytes(8 - len(data) % 8)
+    for (w,) in struct.iter_unpack('<Q', data):
+        h = ((h ^ w) * FNV_PRIME) & MASK64
+    return h
+
+
+def fnv1a(s):
+    h = 0xCBF29CE484222325
+    for c in s.encode():
+        h = ((h ^ c) * FNV_PRIME) & MASK64
+    return h
+
+
+def sections(dat):
+    assert dat[:8] == b'CIRCMDAT'
+    count = struct.unpack_from('<I', dat, 24)[0]
+    out = {}
+    for i in range(count):
+        kind, _, offset, length, _ = struct.unpack_from('<IIQQQ', dat, 40 + 32 * i)
+        out[kind] = dat[offset:offset + length]
+    return out
+
+
+def element(buf, off):
+    short, kind = struct.unpack_from('<iI', buf, off)
+    v = int.from_bytes(buf[off + 8:off + 40], 'little')
+    if kind & 0x80000000:
+        return v * R_INV % Q if kind & 0x40000000 else v
+    return short % Q
+
+
+def signed(x):
+    return x - Q if x > (Q - 1) // 2 else x
+
+
+def main():
+    sec = sections(open(sys.argv[1], 'rb').read())
+    inputs = {h: (sid, size) for h, sid, size in struct.iter_unpack('<QQQ', sec[1]) if size}
+    c = [element(sec[3], off) for off in range(0, len(sec[3]), 40)]
+    witness = []
+    for signal, count in struct.iter_unpack('<QQ', sec[5]):
+        witness.extend(range(signal, signal + count))
+
+    sig = [None] * 150102
+    sig[0] = 1
+    for name, value in json.load(open(sys.argv[2])).items():
+        sid, size = inputs[fnv1a(name)]
+        values = value if isinstance(value, list) else [value]
+        assert len(values) == size
+        for k, x in enumerate(values):
+            sig[sid + k] = int(x) % Q
+
+    # RealRSALike_1_run: main 은 신호 1 에서 시작, IsZero 는 main + 150098
+    s = 1
+    sig[s + 98] = sig[s + 1] * sig[s + 1] % Q
+    i = c[1]
+    while signed(i) < signed(c[4]):
+        sig[s + 98 + i] = (sig[s + 98 + i - 1] ** 2 + sig[s + 33 + i % c[2]] + sig[s + 65 + i % c[2]] * c[0]) % Q
+        i += 1
+    z = s + 150098
+    sig[z + 1] = (sig[s + 150097] - sig[s + 150097]) % Q
+    sig[z + 2] = c[1] * pow(sig[z + 1], -1, Q) % Q if sig[z + 1] else c[0]
+    sig[z + 0] = (-sig[z + 1] * sig[z + 2] + c[1]) % Q
+    sig[s + 0] = (c[1] - sig[z + 0]) % Q
+
+    # native-witness.cpp 의 writeBinWitness 와 같은 .wtns 배치
+    n = len(witness)
+    wtns = b'wtns' + struct.pack('<IIIQI', 2, 2, 1, 8 + 32, 32) + Q.to_bytes(32, 'little')
+    wtns += struct.pack('<IIQ', n, 2, 32 * n)
+    wtns += b''.join(sig[w].to_bytes(32, 'little') for w in witness)
+
+    print('size %d' % len(wtns))
+    print('checksum %016x' % checksum(wtns))
+    samples = list(range(10)) + [95, 96, 97, 98, 99, 100, n // 2] + list(range(n - 5, n))
+    for w in samples:
+        print('w %d %d' % (w, sig[witness[w]]))
+
+
+if __name__ == '__main__':
+    main()
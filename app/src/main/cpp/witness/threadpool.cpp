@@ -0,0 +1,100 @@
+#include "../native_log.hpp"
+#include "threadpool.hpp"
+#include "calcwit.hpp"
+
+#define TAG "NativeThreadPool"
+#define LOGD(...) NATIVE_LOGD(TAG, __VA_ARGS__)
+
+// 지금 스레드가 어느 풀의 몇 번 큐를 쓰는지 (작업 스레드가 아니면 null)
+static thread_local const Circom_ThreadPool *tlsPool = nullptr;
+static thread_local uint tlsQueue = 0;
+
+Circom_ThreadPool::Circom_ThreadPool(uint nThreads) : pending(0), sleepers(0), waiters(0), stopping(false) {
+    if (nThreads < 1) nThreads = 1;
+    for (uint i = 0; i < nThreads; i++) queues.push_back(new Queue());
+    for (uint i = 1; i < nThreads; i++) {
+        workers.emplace_back(&Circom_ThreadPool::workerLoop, this, i);
+    }
+    LOGD("🧵 Thread pool started: %u threads", nThreads);
+}
+
+Circom_ThreadPool::~Circom_ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+    for (size_t i = 0; i < queues.size(); i++) delete queues[i];
+}
+
+uint Circom_ThreadPool::currentQueue() const {
+    return tlsPool == this ? tlsQueue : 0;
+}
+
+void Circom_ThreadPool::submit(const Circom_Task &task) {
+    Queue *q = queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> guard(q->lock);
+        q->tasks.push_back(task);
+    }
+    // pending 증가와 sleepers 확인은 둘 다 seq_cst 이므로, 잠들려는 스레드는 pending 을 보거나 여기서 깨워진다
+    pending++;
+    if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wake.notify_one();
+    }
+}
+
+void Circom_ThreadPool::notifyWaiters() {
+    // 호출한 쪽의 ready 쓰기가 waiters 읽기보다 먼저 보이게 한다 (잠드는 쪽은 waiters 증가 후 ready 를 읽는다)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load() > 0) {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wake.notify_all();
+    }
+}
+
+bool Circom_ThreadPool::popLocal(uint q, Circom_Task &task) {
+    Queue *queue = queues[q];
+    std::lock_guard<std::mutex> guard(queue->lock);
+    if (queue->tasks.empty()) return false;
+    task = queue->tasks.back();
+    queue->tasks.pop_back();
+    return true;
+}
+
+bool Circom_ThreadPool::steal(uint q, Circom_Task &task) {
+    uint n = (uint)queues.size();
+    for (uint k = 1; k < n; k++) {
+        Queue *queue = queues[(q + k) % n];
+        std::lock_guard<std::mutex> guard(queue->lock);
+        if (queue->tasks.empty()) continue;
+        task = queue->tasks.front();
+        queue->tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool Circom_ThreadPool::runOne() {
+    if (pending.load(std::memory_order_relaxed) == 0) return false;
+    uint q = currentQueue();
+    Circom_Task task;
+    if (!popLocal(q, task) && !steal(q, task)) return false;
+    pending--;
+    task.ctx->runParallelTask(task);
+    return true;
+}
+
+void Circom_ThreadPool::workerLoop(uint q) {
+    tlsPool = this;
+    tlsQueue = q;
+    while (!stopping.load()) {
+        if (runOne()) continue;
+        std::unique_lock<std::mutex> lk(sleepLock);
+        sleepers++;
+        wake.wait(lk, [this]() { return stopping.load() || pending.load() > 0; });
+        sleepers--;
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef CIRCOM_THREADPOOL_HPP
+#define CIRCOM_THREADPOOL_HPP
+
+// 병렬 컴포넌트 실행용 work-stealing 스레드 풀.
+// 스레드마다 deque 가 있고, 자기 deque 는 뒤에서 (LIFO, 방금 만든 자식부터) 꺼내고
+// 일이 없으면 다른 스레드의 deque 앞에서 (FIFO, 오래된 큰 작업부터) 훔친다.
+// 풀의 크기 n 에는 호출 스레드가 포함된다: 작업 스레드는 n - 1 개이고, 결과를 기다리는 스레드는
+// 그동안 helpUntil() 로 다른 작업을 대신 실행한다 (부모는 자기 자식만 기다리므로 교착이 없다).
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+
+class Circom_CalcWit;
+
+typedef void (*Circom_TaskFunction)(uint cIdx, Circom_CalcWit *ctx);
+
+struct Circom_Task {
+    Circom_TaskFunction fn;
+    uint cIdx;
+    Circom_CalcWit *ctx;
+};
+
+class Circom_ThreadPool {
+public:
+    explicit Circom_ThreadPool(uint nThreads);
+    ~Circom_ThreadPool();
+
+    void submit(const Circom_Task &task);
+
+    // 대기 중인 작업 하나를 이 스레드에서 실행한다. 실행할 것이 없으면 false
+    bool runOne();
+
+    uint size() const { return (uint)queues.size(); }
+
+    // ready() 가 참이 될 때까지 대기 중인 작업을 대신 실행한다. 실행할 것이 없으면 WAIT_SPINS 번까지는
+    // 양보만 하고, 그 뒤에는 새 작업이나 notifyWaiters() 가 올 때까지 잠든다.
+    // ready() 를 참으로 만드는 쪽은 값을 쓴 뒤 notifyWaiters() 를 불러야 한다.
+    template <typename Ready>
+    void helpUntil(Ready ready) {
+        uint spins = 0;
+        while (!ready()) {
+            if (runOne()) {
+                spins = 0;
+            } else if (spins < WAIT_SPINS) {
+                spins++;
+                std::this_thread::yield();
+            } else {
+                std::unique_lock<std::mutex> lk(sleepLock);
+                sleepers++;
+                waiters++;
+                wake.wait(lk, [this, &ready]() { return pending.load() > 0 || ready(); });
+                waiters--;
+                sleepers--;
+            }
+        }
+    }
+
+    void notifyWaiters();
+
+private:
+    static const uint WAIT_SPINS = 64;
+
+    struct Queue {
+        std::mutex lock;
+        std::deque<Circom_Task> tasks;
+    };
+
+    std::vector<Queue *> queues;    // [0] 은 작업 스레드가 아닌 호출 스레드들이 같이 쓴다
+    std::vector<std::thread> workers;
+    std::atomic<uint> pending;      // 큐에 들어 있는 (아직 꺼내지 않은) 작업 수
+    std::atomic<uint> sleepers;     // 잠든 스레드 수 (작업 스레드 + helpUntil)
+    std::atomic<uint> waiters;      // 그중 helpUntil 에서 잠든 수
+    std::atomic<bool> stopping;
+    std::mutex sleepLock;
+    std::condition_variable wake;
+
+    uint currentQueue() const;
+    bool popLocal(uint q, Circom_Task &task);
+    bool steal(uint q, Circom_Task &task);
+    void workerLoop(uint q);
+};
+
+#endif // CIRCOM_THREADPOOL_HPP
@@ -0,0 +1,224 @@
+// 회로 witness 를 기준 파일과 비교하는 검사 (WITNESS_BUILD_TESTS=ON 일 때만 빌드, ctest 로 실행)
+// 기준 파일은 testdata/realrsalike_model.py 가 Python 정수로 따로 계산한 .wtns 의 크기, checksum, 일부 witness 값이다.
+// 스레드 1개와 4개로 각각, 같은 Circom_CalcWit 를 reset() 으로 재사용해 세 번 계산해 .wtns 를 쓰고 비교한다
+// 회로 캐시 (acquireCircuit / releaseCircuit / unloadCircuits) 의 공유, 파일 교체, 지연 해제도 본다
+// (WITNESS_TEST_ASAN=ON 으로 빌드하면 재사용 중이나 해제 순서의 잘못된 메모리 접근, 누수도 잡힌다).
+// 사용법: witness-check <circuit.dat> <입력 json> <기준 .ref> [출력 .wtns]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gmp.h>
+#include "calcwit.hpp"
+#include "datfile.hpp"
+
+// native-witness.cpp
+Circom_Circuit *loadCircuit(std::string const &datFileName, bool zeroCopy);
+void freeCircuit(Circom_Circuit *circuit);
+void computeWitness(Circom_CalcWit *ctx, const char *input_json, const char *wtns_path);
+Circom_Circuit *acquireCircuit(std::string const &datFileName);
+void releaseCircuit(Circom_Circuit *circuit);
+uint unloadCircuits(std::string const &datFileName);
+
+static bool readFile(const char *path, std::string &out) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    std::stringstream ss;
+    ss << f.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+// .wtns 의 witness 값 (section 2, 헤더 뒤 32바이트씩) 을 10진 문자열로
+static std::string witnessValue(const std::string &wtns, size_t index) {
+    const size_t header = 4 + 4 + 4 + (4 + 8 + 4 + 32 + 4) + (4 + 8);
+    mpz_t v; mpz_init(v);
+    mpz_import(v, 4, -1, 8, -1, 0, wtns.data() + header + index * 32);
+    char *s = mpz_get_str(nullptr, 10, v);
+    std::string r(s);
+    free(s);
+    mpz_clear(v);
+    return r;
+}
+
+static int compare(const std::string &wtns, const char *refPath, const char *label) {
+    std::ifstream ref(refPath);
+    if (!ref) {
+        printf("cannot read %s\n", refPath);
+        return 1;
+    }
+    int failures = 0;
+    std::string key;
+    while (ref >> key) {
+        if (key == "size") {
+            size_t size;
+            ref >> size;
+            if (wtns.size() != size) {
+                printf("FAIL [%s] .wtns size %zu, want %zu\n", label, wtns.size(), size);
+                return 1;  // 크기가 다르면 나머지는 읽을 수 없다
+            }
+        } else if (key == "checksum") {
+            std::string want;
+            ref >> want;
+            char got[17];
+            snprintf(got, sizeof(got), "%016llx", (unsigned long long)Circom_datChecksum(wtns.data(), wtns.size()));
+            if (want != got) {
+                printf("FAIL [%s] .wtns checksum %s, want %s\n", label, got, want.c_str());
+                failures++;
+            }
+        } else if (key == "w") {
+            size_t index;
+            std::string want;
+            ref >> index >> want;
+            std::string got = witnessValue(wtns, index);
+            if (got != want) {
+                printf("FAIL [%s] witness %zu = %s, want %s\n", label, index, got.c_str(), want.c_str());
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+static bool writeFile(const std::string &path, const std::string &data) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f.write(data.data(), data.size());
+    return (bool)f;
+}
+
+// 빌린 회로로 witness 를 계산해 기준과 비교한다
+static int witnessWith(Circom_Circuit *circuit, const std::string &input, const char *refPath,
+                       const std::string &outPath, const char *label) {
+    Circom_CalcWit *ctx = new Circom_CalcWit(circuit, 1);
+    int failures = 0;
+    try {
+        std::string wtns;
+        computeWitness(ctx, input.c_str(), outPath.c_str());
+        if (!readFile(outPath.c_str(), wtns)) throw std::runtime_error("cannot read " + outPath);
+        failures += compare(wtns, refPath, label);
+    } catch (const std::exception &e) {
+        printf("FAIL [%s] %s\n", label, e.what());
+        failures++;
+    }
+    delete ctx;
+    return failures;
+}
+
+#define CACHE_CHECK(cond, what) do { if (!(cond)) { printf("FAIL [cache] %s\n", what); failures++; } } while (0)
+
+// 회로 캐시: 같은 파일은 같은 회로를 빌려 주고, 파일이 바뀌면 새로 로드하되 빌려 간 옛 회로는 돌려줄 때까지 살아 있고,
+// unloadCircuits 는 빌려 간 회로를 마지막 releaseCircuit 때 해제한다
+static int checkCache(const char *datPath, const std::string &input, const char *refPath, const std::string &outPath) {
+    int failures = 0;
+    std::string dat;
+    if (!readFile(datPath, dat)) {
+        printf("cannot read %s\n", datPath);
+        return 1;
+    }
+    std::string path = outPath + ".dat";
+    std::string next = outPath + ".dat.next";
+    CACHE_CHECK(writeFile(path, dat), "cannot write the circuit copy");
+
+    Circom_Circuit *a = acquireCircuit(path);
+    Circom_Circuit *b = acquireCircuit(path);
+    CACHE_CHECK(a && a == b, "two borrowers of the same file get different circuits");
+    releaseCircuit(b);
+    Circom_Circuit *c = acquireCircuit(path);
+    CACHE_CHECK(c == a, "an idle cached circuit was not reused");
+    releaseCircuit(c);
+
+    // 파일 교체 (새 inode): 새 회로를 주고, 아직 빌려 간 a 는 그대로 써야 한다
+    CACHE_CHECK(writeFile(next, dat) && rename(next.c_str(), path.c_str()) == 0, "cannot replace the circuit copy");
+    Circom_Circuit *d = acquireCircuit(path);
+    CACHE_CHECK(d && d != a, "a replaced file returned the old circuit");
+    if (a) failures += witnessWith(a, input, refPath, outPath, "cache, old circuit after replace");
+    releaseCircuit(a);
+
+    // 빌려 간 동안 내리면 마지막 release 때 해제
+    CACHE_CHECK(unloadCircuits(path) == 1, "unloadCircuits did not count the borrowed entry");
+    if (d) failures += witnessWith(d, input, refPath, outPath, "cache, borrowed circuit after unload");
+    releaseCircuit(d);
+
+    // 내린 뒤에는 새로 로드하고, 쉬고 있는 항목은 바로 해제
+    Circom_Circuit *e = acquireCircuit(path);
+    CACHE_CHECK(e != NULL, "reload after unload failed");
+    releaseCircuit(e);
+    CACHE_CHECK(unloadCircuits(path) == 1, "unloadCircuits did not count the idle entry");
+    CACHE_CHECK(unloadCircuits(path) == 0, "unloadCircuits found an entry twice");
+    CACHE_CHECK(acquireCircuit(path + ".missing") == NULL, "a missing file was loaded");
+
+    remove(path.c_str());
+    return failures;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <circuit.dat> <input.json> <reference.ref> [out.wtns]\n", argv[0]);
+        return 2;
+    }
+    std::string outPath = argc > 4 ? argv[4] : "witness-check.wtns";
+    std::string input;
+    if (!readFile(argv[2], input)) {
+        printf("cannot read %s\n", argv[2]);
+        return 1;
+    }
+    Circom_Circuit *circuit = loadCircuit(argv[1], true);
+    if (!circuit) {
+        printf("cannot load %s\n", argv[1]);
+        return 1;
+    }
+
+    int failures = 0;
+    for (uint threads : {1u, 4u}) {
+        Circom_CalcWit *ctx = new Circom_CalcWit(circuit, threads);
+        for (int run = 0; run < 3; run++) {
+            char label[64];
+            snprintf(label, sizeof(label), "%u threads, run %d", threads, run);
+            std::string wtns;
+            try {
+                if (run > 0) ctx->reset();
+                computeWitness(ctx, input.c_str(), outPath.c_str());
+                if (!readFile(outPath.c_str(), wtns)) throw std::runtime_error("cannot read " + outPath);
+                failures += compare(wtns, argv[3], label);
+            } catch (const std::exception &e) {
+                printf("FAIL [%s] %s\n", label, e.what());
+                failures++;
+            }
+        }
+        delete ctx;
+    }
+    freeCircuit(circuit);
+
+    // 복사 로드는 매핑을 닫으므로 구간 표도 비어 있어야 한다
+    circuit = loadCircuit(argv[1], false);
+    if (!circuit) {
+        printf("cannot load %s (copy)\n", argv[1]);
+        return 1;
+    }
+    size_t len;
+    if (circuit->dataMapped || circuit->dat.locate(Circom_DAT_CONSTANTS, len)) {
+        printf("FAIL [copy load] section table still points into the closed mapping\n");
+        failures++;
+    }
+    try {
+        Circom_CalcWit ctx(circuit, 1);
+        std::string wtns;
+        computeWitness(&ctx, input.c_str(), outPath.c_str());
+        if (!readFile(outPath.c_str(), wtns)) throw std::runtime_error("cannot read " + outPath);
+        failures += compare(wtns, argv[3], "copy load");
+    } catch (const std::exception &e) {
+        printf("FAIL [copy load] %s\n", e.what());
+        failures++;
+    }
+    freeCircuit(circuit);
+
+    failures += checkCache(argv[1], input, argv[3], outPath);
+    remove(outPath.c_str());
+
+    printf("witness-check: %d failures\n", failures);
+    return failures ? 1 : 0;
+}
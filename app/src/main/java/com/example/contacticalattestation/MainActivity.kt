@@ -2,6 +2,7 @@ package com.example.contacticalattestation
 
 import android.content.Context
 import android.content.Intent
+import android.content.res.AssetFileDescriptor
 import android.os.Bundle
 import android.util.Base64
 import android.util.Log
@@ -25,6 +26,7 @@ import kotlinx.coroutines.launch
 import kotlinx.coroutines.withContext
 import java.io.File
 import java.io.FileOutputStream
+import java.io.IOException
 import java.nio.charset.StandardCharsets
 import java.security.KeyStore
 import java.security.Signature
@@ -148,9 +150,7 @@ class MainActivity : AppCompatActivity() {
             // [수정됨] D. ZK 입력 생성 및 Witness 계산 (Real-Time!)
 
             // 1. 필요한 파일 준비
-            // zkey와 dat 파일은 불변이므로 Assets에서 복사
-            val zkeyPath = copyAssetToCache(applicationContext, "circuit.zkey")
-            val datPath = copyAssetToCache(applicationContext, "circuit.dat") // witness 계산용
+            // zkey와 dat 파일은 불변이므로 APK 안의 asset 을 네이티브가 바로 매핑한다 (calcWitnessFromAsset / generateProofFromAsset)
 
             // 2. 결과물이 저장될 경로 지정 (매번 새로 씀)
             val wtnsPath = File(applicationContext.cacheDir, "witness.wtns").absolutePath
@@ -178,7 +178,7 @@ class MainActivity : AppCompatActivity() {
             // 20초가 지나면 TimeoutCancellationException이 발생하여 앱이 멈추지 않고 다음으로 넘어갑니다.
             val witnessSuccess = try {
                 withTimeout(20_000L) {
-                    nativeWitness.calcWitness(zkInputJsonStr, datPath, wtnsPath)
+                    calcWitnessFromAsset(nativeWitness, zkInputJsonStr, wtnsPath)
                 }
             } catch (e: kotlinx.coroutines.TimeoutCancellationException) {
                 Log.e(TAG, "⏰ Witness Calculation Timed Out! (C++ Deadlock or Slow)")
@@ -194,7 +194,7 @@ class MainActivity : AppCompatActivity() {
             // 5. Proof 생성 (Rapidsnark C++ Native)
             // (circuit.zkey + 방금 만든 witness.wtns -> proof)
             val nativeProver = NativeProver()
-            val proofJson = nativeProver.generateProof(zkeyPath, wtnsPath)
+            val proofJson = generateProofFromAsset(nativeProver, wtnsPath)
 
             if (proofJson == "ERROR") {
                 Log.e("ZkLogin", "❌ Proof Generation Failed inside C++")
@@ -308,6 +308,42 @@ class MainActivity : AppCompatActivity() {
     }
 
 
+    /**
+     * 압축되지 않은 asset 을 APK 안의 구간 (fd / startOffset / length) 으로 연다.
+     * 압축된 asset 이면 openFd 가 실패하므로 null 을 돌려주고, 그때는 copyAssetToCache 로 대신한다.
+     */
+    private fun openAssetFd(context: Context, fileName: String): AssetFileDescriptor? =
+        try {
+            context.assets.openFd(fileName)
+        } catch (e: IOException) {
+            Log.w(TAG, "⚠️ Asset is compressed, falling back to copy: $fileName")
+            null
+        }
+
+    // AssetFileDescriptor 의 길이. 알 수 없으면 0 (네이티브는 파일 끝까지로 본다)
+    private fun AssetFileDescriptor.rangeLength(): Long =
+        if (length == AssetFileDescriptor.UNKNOWN_LENGTH) 0L else length
+
+    // circuit.dat 을 APK 에서 바로 매핑해 witness 를 계산한다. fd 는 호출이 끝나면 닫는다 (네이티브 캐시는 매핑을 유지)
+    private fun calcWitnessFromAsset(nativeWitness: NativeWitness, inputJson: String, wtnsPath: String): Boolean {
+        openAssetFd(applicationContext, "circuit.dat")?.use { afd ->
+            return nativeWitness.calcWitnessFd(
+                inputJson, afd.parcelFileDescriptor.fd, afd.startOffset, afd.rangeLength(), wtnsPath
+            )
+        }
+        return nativeWitness.calcWitness(inputJson, copyAssetToCache(applicationContext, "circuit.dat"), wtnsPath)
+    }
+
+    // circuit.zkey 를 APK 에서 바로 매핑해 증명을 만든다
+    private fun generateProofFromAsset(nativeProver: NativeProver, wtnsPath: String): String {
+        openAssetFd(applicationContext, "circuit.zkey")?.use { afd ->
+            return nativeProver.generateProofFd(
+                afd.parcelFileDescriptor.fd, afd.startOffset, afd.rangeLength(), wtnsPath
+            )
+        }
+        return nativeProver.generateProof(copyAssetToCache(applicationContext, "circuit.zkey"), wtnsPath)
+    }
+
     fun copyAssetToCache(context: Context, fileName: String): String {
         val file = File(context.cacheDir, fileName)
 
@@ -9,4 +9,11 @@ class NativeProver {
 
     // [수정됨] 이제 JSON이 아니라 파일 경로 2개를 받습니다.
     external fun generateProof(zkeyPath: String, wtnsPath: String): String
+
+    /**
+     * generateProof 와 같지만 zkey 를 열린 fd 의 [zkeyOffset, zkeyOffset + zkeyLength) 구간에서 바로 매핑한다.
+     * 압축되지 않은 asset 의 AssetFileDescriptor 를 넘기면 캐시 디렉터리로 복사할 필요가 없다.
+     * @param zkeyLength: 구간 길이. 0 이면 파일 끝까지
+     */
+    external fun generateProofFd(zkeyFd: Int, zkeyOffset: Long, zkeyLength: Long, wtnsPath: String): String
 }
\ No newline at end of file
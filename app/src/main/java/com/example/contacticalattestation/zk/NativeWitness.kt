@@ -8,9 +8,46 @@ class NativeWitness {
     }
 
     /**
+     * 회로는 프로세스 캐시에 남아 다음 호출부터 다시 로드하지 않는다 (파일이 바뀌면 다시 로드).
      * @param inputJsonStr: ZK 입력값 (JSON String)
      * @param datPath: assets에서 복사한 circuit.dat 파일 경로
      * @param wtnsPath: 결과물이 저장될 .wtns 파일 경로
      */
     external fun calcWitness(inputJsonStr: String, datPath: String, wtnsPath: String): Boolean
-}
\ No newline at end of file
+
+    /**
+     * calcWitness 와 같지만 circuit.dat 을 열린 fd 의 [datOffset, datOffset + datLength) 구간에서 바로 매핑한다.
+     * 압축되지 않은 asset 의 AssetFileDescriptor (parcelFileDescriptor.fd / startOffset / length) 를 넘기면
+     * 캐시 디렉터리로 복사할 필요가 없다. fd 는 호출이 끝나면 닫아도 된다.
+     * @param datLength: 구간 길이. 0 이면 파일 끝까지
+     */
+    external fun calcWitnessFd(inputJsonStr: String, datFd: Int, datOffset: Long, datLength: Long, wtnsPath: String): Boolean
+
+    /**
+     * 회로(.dat)를 한 번 로드하고 신호 버퍼를 할당해 둔 네이티브 컨텍스트를 만든다.
+     * 연속으로 witness 를 만들 때 calcWitness 대신 이 핸들을 재사용한다.
+     * @param numThreads: 병렬 컴포넌트를 실행할 스레드 수 (호출 스레드 포함). 0 이면 코어 수
+     * @return 핸들 (실패하면 0). 다 쓴 뒤 releaseContext 로 해제해야 한다.
+     */
+    external fun createContext(datPath: String, numThreads: Int): Long
+
+    /**
+     * createContext 와 같지만 circuit.dat 을 열린 fd 의 구간에서 매핑한다 (calcWitnessFd 참고).
+     */
+    external fun createContextFd(datFd: Int, datOffset: Long, datLength: Long, numThreads: Int): Long
+
+    /**
+     * createContext 의 핸들로 witness 를 계산한다. 버퍼는 재할당 없이 초기화만 한다.
+     * 같은 핸들로 동시에 호출하면 차례로 실행된다.
+     */
+    external fun calcWitnessWithContext(handle: Long, inputJsonStr: String, wtnsPath: String): Boolean
+
+    external fun releaseContext(handle: Long)
+
+    /**
+     * 캐시된 회로(.dat 매핑)를 내린다. 아직 쓰는 컨텍스트가 있으면 그 컨텍스트가 해제될 때 메모리가 반환된다.
+     * @param datPath: 내릴 회로 경로. 빈 문자열이면 fd 로 로드한 회로까지 전부
+     * @return 내린 회로 수
+     */
+    external fun unloadCircuit(datPath: String): Int
+}